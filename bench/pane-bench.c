@@ -0,0 +1,621 @@
+/* $OpenBSD$ */
+
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF MIND, USE, DATA OR PROFITS, WHETHER
+ * IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING
+ * OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+
+#include <fcntl.h>
+#include <locale.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "tmux.h"
+
+/* Benchmark builds make the main in tmux.c weak so this one is used. */
+#undef main
+
+/*
+ * Throughput benchmark for the pane pipeline. Each workload is fed in chunks
+ * through input_parse_buffer into a pane, and whatever is drawn is written to
+ * a client with a built in terminal description whose output is thrown away.
+ * Synthetic workloads are generated from a fixed seed so every run sees the
+ * same input; recordings (for example from pipe-pane) may be given as
+ * arguments.
+ */
+
+#define BENCH_WIDTH 80
+#define BENCH_HEIGHT 24
+
+struct bench_workload {
+	const char	*name;
+	void		 (*generate)(struct evbuffer *, size_t);
+};
+
+static struct event_base	*bench_base;
+static struct client		*bench_client;
+static struct window_pane	*bench_pane;
+static uint32_t			 bench_seed;
+
+static u_int			 bench_chunk = 4096;
+static u_int			 bench_iterations = 3;
+static size_t			 bench_size = 8 * 1024 * 1024;
+
+/* Terminal for the client, similar to xterm-256color. */
+static const char *bench_caps[] = {
+	"acsc=``aaffggiijjkkllmmnnooppqqrrssttuuvvwwxxyyzz{{||}}~~",
+	"am=1",
+	"bce=1",
+	"blink=\033[5m",
+	"bold=\033[1m",
+	"civis=\033[?25l",
+	"clear=\033[H\033[2J",
+	"cnorm=\033[?12l\033[?25h",
+	"colors=256",
+	"cols=80",
+	"csr=\033[%i%p1%d;%p2%dr",
+	"cub=\033[%p1%dD",
+	"cub1=\010",
+	"cud=\033[%p1%dB",
+	"cud1=\n",
+	"cuf=\033[%p1%dC",
+	"cuf1=\033[C",
+	"cup=\033[%i%p1%d;%p2%dH",
+	"cuu=\033[%p1%dA",
+	"cuu1=\033[A",
+	"dch=\033[%p1%dP",
+	"dch1=\033[P",
+	"dim=\033[2m",
+	"dl=\033[%p1%dM",
+	"dl1=\033[M",
+	"ech=\033[%p1%dX",
+	"ed=\033[J",
+	"el=\033[K",
+	"el1=\033[1K",
+	"home=\033[H",
+	"hpa=\033[%i%p1%dG",
+	"ich=\033[%p1%d@",
+	"il=\033[%p1%dL",
+	"il1=\033[L",
+	"ind=\n",
+	"indn=\033[%p1%dS",
+	"invis=\033[8m",
+	"lines=24",
+	"rev=\033[7m",
+	"ri=\033M",
+	"rin=\033[%p1%dT",
+	"ritm=\033[23m",
+	"rmacs=\033(B",
+	"rmcup=\033[?1049l",
+	"rmkx=\033[?1l\033>",
+	"rmso=\033[27m",
+	"rmul=\033[24m",
+	"setab=\033[%?%p1%{8}%<%t4%p1%d%e%p1%{16}%<%t10%p1%{8}%-%d%e48;5;%p1%d%;m",
+	"setaf=\033[%?%p1%{8}%<%t3%p1%d%e%p1%{16}%<%t9%p1%{8}%-%d%e38;5;%p1%d%;m",
+	"sgr0=\033(B\033[m",
+	"sitm=\033[3m",
+	"smacs=\033(0",
+	"smcup=\033[?1049h",
+	"smkx=\033[?1h\033=",
+	"smso=\033[7m",
+	"smul=\033[4m",
+	"vpa=\033[%i%p1%dd",
+	"xenl=1",
+	"XT=1"
+};
+
+static const char *bench_words[] = {
+	"the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "tmux",
+	"window", "pane", "session", "client", "server", "-rw-r--r--", "1024",
+	"/usr/local/bin", "error:", "warning:", "make[2]:", "Entering",
+	"directory", "cc", "-O2", "-Wall", "-c", "input.c", "tty.c", "grid.c"
+};
+
+static void	bench_text(struct evbuffer *, size_t);
+static void	bench_sgr(struct evbuffer *, size_t);
+static void	bench_utf8(struct evbuffer *, size_t);
+static void	bench_tui(struct evbuffer *, size_t);
+static void	bench_scroll(struct evbuffer *, size_t);
+#ifdef ENABLE_SIXEL
+static void	bench_sixel(struct evbuffer *, size_t);
+#endif
+
+static const struct bench_workload bench_workloads[] = {
+	{ "text", bench_text },
+	{ "sgr", bench_sgr },
+	{ "utf8", bench_utf8 },
+	{ "tui", bench_tui },
+	{ "scroll", bench_scroll },
+#ifdef ENABLE_SIXEL
+	{ "sixel", bench_sixel },
+#endif
+};
+
+static __dead void
+usage(void)
+{
+	fprintf(stderr, "usage: %s [-c chunk] [-i iterations] [-s size] "
+	    "[-t workload] [file ...]\n", getprogname());
+	exit(1);
+}
+
+/* Get next pseudo-random number. */
+static u_int
+bench_random(void)
+{
+	bench_seed = bench_seed * 1103515245 + 12345;
+	return ((bench_seed >> 16) & 0x7fff);
+}
+
+/* Get a random word. */
+static const char *
+bench_word(void)
+{
+	return (bench_words[bench_random() % nitems(bench_words)]);
+}
+
+/* Add a UTF-8 character. */
+static void
+bench_add_utf8(struct evbuffer *evb, u_int uc)
+{
+	u_char	buf[4];
+	size_t	len;
+
+	if (uc < 0x800) {
+		buf[0] = 0xc0|(uc >> 6);
+		buf[1] = 0x80|(uc & 0x3f);
+		len = 2;
+	} else if (uc < 0x10000) {
+		buf[0] = 0xe0|(uc >> 12);
+		buf[1] = 0x80|((uc >> 6) & 0x3f);
+		buf[2] = 0x80|(uc & 0x3f);
+		len = 3;
+	} else {
+		buf[0] = 0xf0|(uc >> 18);
+		buf[1] = 0x80|((uc >> 12) & 0x3f);
+		buf[2] = 0x80|((uc >> 6) & 0x3f);
+		buf[3] = 0x80|(uc & 0x3f);
+		len = 4;
+	}
+	evbuffer_add(evb, buf, len);
+}
+
+/* Plain text, like compiler output or cat. */
+static void
+bench_text(struct evbuffer *evb, size_t size)
+{
+	u_int	i, n;
+
+	while (EVBUFFER_LENGTH(evb) < size) {
+		n = bench_random() % 24;
+		for (i = 0; i < n; i++)
+			evbuffer_add_printf(evb, "%s ", bench_word());
+		evbuffer_add(evb, "\r\n", 2);
+	}
+}
+
+/* Text with most words in a different colour or attribute. */
+static void
+bench_sgr(struct evbuffer *evb, size_t size)
+{
+	u_int	i, n;
+
+	while (EVBUFFER_LENGTH(evb) < size) {
+		n = bench_random() % 16;
+		for (i = 0; i < n; i++) {
+			switch (bench_random() % 6) {
+			case 0:
+				evbuffer_add_printf(evb, "\033[3%um",
+				    bench_random() % 8);
+				break;
+			case 1:
+				evbuffer_add_printf(evb, "\033[1;4%um",
+				    bench_random() % 8);
+				break;
+			case 2:
+				evbuffer_add_printf(evb, "\033[38;5;%um",
+				    bench_random() % 256);
+				break;
+			case 3:
+				evbuffer_add_printf(evb, "\033[48;5;%u;4m",
+				    bench_random() % 256);
+				break;
+			case 4:
+				evbuffer_add_printf(evb, "\033[38;2;%u;%u;%um",
+				    bench_random() % 256, bench_random() % 256,
+				    bench_random() % 256);
+				break;
+			}
+			evbuffer_add_printf(evb, "%s\033[m ", bench_word());
+		}
+		evbuffer_add(evb, "\r\n", 2);
+	}
+}
+
+/* Wide CJK characters, emoji and combining characters. */
+static void
+bench_utf8(struct evbuffer *evb, size_t size)
+{
+	u_int	i, n;
+
+	while (EVBUFFER_LENGTH(evb) < size) {
+		n = bench_random() % 40;
+		for (i = 0; i < n; i++) {
+			switch (bench_random() % 8) {
+			case 0:
+				bench_add_utf8(evb, 0x1f600 + bench_random() % 80);
+				break;
+			case 1:
+				/* Woman technologist, joined with ZWJ. */
+				bench_add_utf8(evb, 0x1f469);
+				bench_add_utf8(evb, 0x200d);
+				bench_add_utf8(evb, 0x1f4bb);
+				break;
+			case 2:
+				evbuffer_add(evb, "e", 1);
+				bench_add_utf8(evb, 0x301);
+				break;
+			case 3:
+				bench_add_utf8(evb, 0xac00 + bench_random() % 11172);
+				break;
+			case 4:
+				evbuffer_add_printf(evb, "%s ", bench_word());
+				break;
+			default:
+				bench_add_utf8(evb, 0x4e00 + bench_random() % 20000);
+				break;
+			}
+		}
+		evbuffer_add(evb, "\r\n", 2);
+	}
+}
+
+/* Full screen redraws, like top or a file manager. */
+static void
+bench_tui(struct evbuffer *evb, size_t size)
+{
+	u_int	y, frame = 0;
+
+	evbuffer_add_printf(evb, "\033[?1049h\033[?25l");
+	while (EVBUFFER_LENGTH(evb) < size) {
+		evbuffer_add_printf(evb, "\033[H\033[7m frame %-*u\033[m",
+		    BENCH_WIDTH - 7, frame++);
+		for (y = 1; y < BENCH_HEIGHT - 1; y++) {
+			evbuffer_add_printf(evb, "\033[%u;1H", y + 1);
+			evbuffer_add_printf(evb, "\033[32m%6u\033[m %-9s"
+			    "\033[1;34m%3u.%u\033[m \033[33m%3u.%u\033[m "
+			    "%-12s %s\033[K", bench_random(), bench_word(),
+			    bench_random() % 100, bench_random() % 10,
+			    bench_random() % 100, bench_random() % 10,
+			    bench_word(), bench_word());
+		}
+		evbuffer_add_printf(evb, "\033[%u;1H\033[44;37m%-*s\033[m",
+		    BENCH_HEIGHT, BENCH_WIDTH - 1, "F1 Help  F2 Setup  F10 Quit");
+	}
+	evbuffer_add_printf(evb, "\033[?25h\033[?1049l");
+}
+
+/* Scrolling, inserting and deleting lines inside a scroll region. */
+static void
+bench_scroll(struct evbuffer *evb, size_t size)
+{
+	u_int	i, n;
+
+	evbuffer_add_printf(evb, "\033[2J\033[3;%ur\033[3;1H", BENCH_HEIGHT - 2);
+	while (EVBUFFER_LENGTH(evb) < size) {
+		switch (bench_random() % 8) {
+		case 0:
+			evbuffer_add_printf(evb, "\033[%uL", 1 + bench_random() % 3);
+			break;
+		case 1:
+			evbuffer_add_printf(evb, "\033[%uM", 1 + bench_random() % 3);
+			break;
+		case 2:
+			evbuffer_add_printf(evb, "\033[3;1H\033M\033M");
+			break;
+		case 3:
+			evbuffer_add_printf(evb, "\033[%uS", 1 + bench_random() % 4);
+			break;
+		case 4:
+			evbuffer_add_printf(evb, "\033[%uT", 1 + bench_random() % 4);
+			break;
+		default:
+			n = bench_random() % 12;
+			for (i = 0; i < n; i++)
+				evbuffer_add_printf(evb, "%s ", bench_word());
+			evbuffer_add(evb, "\r\n", 2);
+			break;
+		}
+	}
+	evbuffer_add_printf(evb, "\033[r");
+}
+
+#ifdef ENABLE_SIXEL
+/* Sixel images drawn over each other at the top of the screen. */
+static void
+bench_sixel(struct evbuffer *evb, size_t size)
+{
+	u_int	i, x, y, n, colour, width = 160, height = 96;
+
+	while (EVBUFFER_LENGTH(evb) < size) {
+		evbuffer_add_printf(evb, "\033[H\033P0;1;0q\"1;1;%u;%u", width,
+		    height);
+		for (i = 0; i < 16; i++) {
+			evbuffer_add_printf(evb, "#%u;2;%u;%u;%u", i,
+			    bench_random() % 101, bench_random() % 101,
+			    bench_random() % 101);
+		}
+		for (y = 0; y < height; y += 6) {
+			for (colour = 0; colour < 4; colour++) {
+				evbuffer_add_printf(evb, "#%u",
+				    bench_random() % 16);
+				for (x = 0; x < width; x += n) {
+					n = 1 + bench_random() % 16;
+					if (n > width - x)
+						n = width - x;
+					evbuffer_add_printf(evb, "!%u%c", n,
+					    63 + bench_random() % 64);
+				}
+				evbuffer_add(evb, "$", 1);
+			}
+			evbuffer_add(evb, "-", 1);
+		}
+		evbuffer_add(evb, "\033\\", 2);
+	}
+}
+#endif
+
+/* Set up options, a session with one pane and a client attached to it. */
+static void
+bench_init(void)
+{
+	const struct options_table_entry	*oe;
+	struct session				*s;
+	struct window				*w;
+	struct window_pane			*wp;
+	struct winlink				*wl;
+	struct client				*c;
+	struct bufferevent			*vpty[2];
+	int					 feat = 0;
+	u_int					 hlimit;
+	char					*cause;
+
+	global_environ = environ_create();
+	global_options = options_create(NULL);
+	global_s_options = options_create(NULL);
+	global_w_options = options_create(NULL);
+	for (oe = options_table; oe->name != NULL; oe++) {
+		if (oe->scope & OPTIONS_TABLE_SERVER)
+			options_default(global_options, oe);
+		if (oe->scope & OPTIONS_TABLE_SESSION)
+			options_default(global_s_options, oe);
+		if (oe->scope & OPTIONS_TABLE_WINDOW)
+			options_default(global_w_options, oe);
+	}
+	bench_base = osdep_event_init();
+
+	RB_INIT(&windows);
+	RB_INIT(&all_window_panes);
+	TAILQ_INIT(&clients);
+	RB_INIT(&sessions);
+	TAILQ_INIT(&message_log);
+
+	options_set_number(global_w_options, "automatic-rename", 0);
+	options_set_number(global_w_options, "monitor-bell", 0);
+	socket_path = xstrdup("bench");
+
+	s = session_create(NULL, "bench", "/", environ_create(),
+	    options_create(global_s_options), NULL);
+	hlimit = options_get_number(s->options, "history-limit");
+
+	w = window_create(BENCH_WIDTH, BENCH_HEIGHT, 8, 16);
+	wp = window_add_pane(w, NULL, hlimit, 0);
+	layout_init(w, wp);
+	window_set_active_pane(w, wp, 0);
+	if ((wl = session_attach(s, w, 0, &cause)) == NULL)
+		errx(1, "%s", cause);
+	session_select(s, wl->idx);
+
+	bufferevent_pair_new(bench_base, BEV_OPT_CLOSE_ON_FREE, vpty);
+	wp->ictx = input_init(wp, vpty[0], &wp->palette, NULL);
+	bench_pane = wp;
+
+	c = xcalloc(1, sizeof *c);
+	c->references = 1;
+	c->name = xstrdup("bench");
+	c->term_name = xstrdup("bench");
+	c->environ = environ_create();
+	c->fd = c->out_fd = -1;
+	c->queue = cmdq_new();
+	RB_INIT(&c->windows);
+	RB_INIT(&c->files);
+	TAILQ_INIT(&c->input_requests);
+	status_init(c);
+	c->keytable = key_bindings_get_table("root", 1);
+	c->keytable->references++;
+	c->flags |= (CLIENT_TERMINAL|CLIENT_FOCUSED|CLIENT_REDRAWWINDOW);
+	c->session = s;
+	session_add_ref(s, __func__);
+	TAILQ_INSERT_TAIL(&clients, c, entry);
+
+	c->tty.client = c;
+	c->tty.cstyle = SCREEN_CURSOR_DEFAULT;
+	c->tty.ccolour = -1;
+	c->tty.fg = c->tty.bg = -1;
+	c->tty.mouse_last_pane = -1;
+	c->tty.in = evbuffer_new();
+	c->tty.out = evbuffer_new();
+	if (c->tty.in == NULL || c->tty.out == NULL)
+		fatalx("out of memory");
+	tty_set_size(&c->tty, BENCH_WIDTH, BENCH_HEIGHT + 1, 8, 16);
+	tty_add_features(&feat, "256,RGB,sixel", ",");
+	c->tty.term = tty_term_create(&c->tty, c->term_name, (char **)bench_caps,
+	    nitems(bench_caps), &feat, &cause);
+	if (c->tty.term == NULL)
+		errx(1, "%s", cause);
+	c->tty.flags |= TTY_OPENED;
+	tty_update_client_offset(c);
+	bench_client = c;
+}
+
+/* Run the event loop and redraw, then throw away anything written. */
+static size_t
+bench_flush(void)
+{
+	struct evbuffer	*out = bench_client->tty.out;
+	size_t		 size;
+
+	size = EVBUFFER_LENGTH(out);
+	evbuffer_drain(out, size);
+
+	while (cmdq_next(NULL) != 0)
+		;
+	server_client_loop();
+	if (event_base_loop(bench_base, EVLOOP_NONBLOCK) == -1)
+		errx(1, "event_base_loop failed");
+
+	size += EVBUFFER_LENGTH(out);
+	evbuffer_drain(out, EVBUFFER_LENGTH(out));
+	return (size);
+}
+
+/* Run a workload and print the best of the iterations. */
+static void
+bench_run(const char *name, struct evbuffer *evb)
+{
+	struct window_pane	*wp = bench_pane;
+	u_char			*data = EVBUFFER_DATA(evb);
+	size_t			 size = EVBUFFER_LENGTH(evb), off, n, out = 0;
+	uint64_t		 start, t, best = UINT64_MAX;
+	uint64_t		 cells = 0, allocs = 0;
+	u_int			 i;
+
+	for (i = 0; i < bench_iterations; i++) {
+		input_reset(wp->ictx, 1);
+		grid_clear_history(wp->base.grid);
+		bench_client->flags |= CLIENT_REDRAWWINDOW;
+		bench_flush();
+
+		cells = wp->cells_written;
+		allocs = xmalloc_count;
+		out = 0;
+
+		start = stats_time();
+		for (off = 0; off < size; off += n) {
+			n = size - off;
+			if (n > bench_chunk)
+				n = bench_chunk;
+			input_parse_buffer(wp, data + off, n);
+			out += bench_flush();
+		}
+		t = stats_time() - start;
+
+		cells = wp->cells_written - cells;
+		allocs = xmalloc_count - allocs;
+		if (t < best)
+			best = t;
+	}
+	if (best == 0)
+		best = 1;
+
+	printf("%-12s %10zu %9.1f %12.0f %10zu %10llu\n", name, size,
+	    (double)size / best, (double)cells * 1000000 / best, out,
+	    (unsigned long long)allocs);
+}
+
+/* Read a recorded workload from a file. */
+static struct evbuffer *
+bench_load(const char *path)
+{
+	struct evbuffer	*evb;
+	int		 fd, n;
+
+	if ((fd = open(path, O_RDONLY)) == -1)
+		err(1, "%s", path);
+	if ((evb = evbuffer_new()) == NULL)
+		fatalx("out of memory");
+	while ((n = evbuffer_read(evb, fd, -1)) > 0)
+		/* nothing */;
+	if (n == -1)
+		err(1, "%s", path);
+	close(fd);
+	return (evb);
+}
+
+int
+main(int argc, char **argv)
+{
+	const struct bench_workload	*bw;
+	struct evbuffer			*evb;
+	const char			*only = NULL, *errstr;
+	int				 opt, i;
+
+	if (setlocale(LC_CTYPE, "en_US.UTF-8") == NULL &&
+	    setlocale(LC_CTYPE, "C.UTF-8") == NULL)
+		errx(1, "need UTF-8 locale");
+
+	while ((opt = getopt(argc, argv, "c:i:s:t:")) != -1) {
+		switch (opt) {
+		case 'c':
+			bench_chunk = strtonum(optarg, 1, INT_MAX, &errstr);
+			if (errstr != NULL)
+				errx(1, "chunk size %s", errstr);
+			break;
+		case 'i':
+			bench_iterations = strtonum(optarg, 1, 1000, &errstr);
+			if (errstr != NULL)
+				errx(1, "iterations %s", errstr);
+			break;
+		case 's':
+			bench_size = strtonum(optarg, 1, 1024, &errstr);
+			if (errstr != NULL)
+				errx(1, "size %s", errstr);
+			bench_size *= 1024 * 1024;
+			break;
+		case 't':
+			only = optarg;
+			break;
+		default:
+			usage();
+		}
+	}
+	argc -= optind;
+	argv += optind;
+
+	bench_init();
+
+	printf("%-12s %10s %9s %12s %10s %10s\n", "workload", "bytes", "MB/s",
+	    "cells/s", "output", "allocs");
+	for (bw = bench_workloads; bw < bench_workloads + nitems(bench_workloads);
+	    bw++) {
+		if (only != NULL && strcmp(only, bw->name) != 0)
+			continue;
+		if ((evb = evbuffer_new()) == NULL)
+			fatalx("out of memory");
+		bench_seed = 1;
+		bw->generate(evb, bench_size);
+		bench_run(bw->name, evb);
+		evbuffer_free(evb);
+	}
+	for (i = 0; i < argc; i++) {
+		evb = bench_load(argv[i]);
+		bench_run(argv[i], evb);
+		evbuffer_free(evb);
+	}
+	return (0);
+}
@@ -278,6 +278,7 @@ cmd_capture_pane_history(struct args *args, struct cmdq_item *item,
 		s = &wp->base;
 		gd = wp->base.grid;
 	}
+	grid_reflow_finish(gd);
 
 	Sflag = args_get(args, 'S');
 	if (Sflag != NULL && strcmp(Sflag, "-") == 0)
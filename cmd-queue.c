@@ -604,8 +604,9 @@ cmdq_fire_command(struct cmdq_item *item)
 	struct client		*tc, *saved = item->client;
 	enum cmd_retval		 retval;
 	struct cmd_find_state	*fsp, fs;
-	int			 flags, quiet = 0;
+	int			 flags, quiet = 0, pane;
 	char			*tmp;
+	uint64_t		 t;
 
 	if (cfg_finished)
 		cmdq_add_message(item);
@@ -646,7 +647,13 @@ cmdq_fire_command(struct cmdq_item *item)
 	if (retval == CMD_RETURN_ERROR)
 		goto out;
 
+	if (item->target.wp != NULL)
+		pane = item->target.wp->id;
+	else
+		pane = -1;
+	t = stats_time();
 	retval = entry->exec(cmd, item);
+	stats_stall(t, "command", entry->name, item->client, pane);
 	if (retval == CMD_RETURN_ERROR)
 		goto out;
 
@@ -722,7 +729,13 @@ cmdq_get_error(const char *error)
 static enum cmd_retval
 cmdq_fire_callback(struct cmdq_item *item)
 {
-	return (item->cb(item, item->data));
+	enum cmd_retval	retval;
+	uint64_t	t;
+
+	t = stats_time();
+	retval = item->cb(item, item->data);
+	stats_stall(t, "callback", item->name, item->client, -1);
+	return (retval);
 }
 
 /* Process next item on command queue. */
@@ -768,6 +781,7 @@ cmdq_next(struct client *c)
 		if (~item->flags & CMDQ_FIRED) {
 			item->time = time(NULL);
 			item->number = ++number;
+			global_stats.items++;
 
 			switch (item->type) {
 			case CMDQ_COMMAND:
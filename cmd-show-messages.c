@@ -38,8 +38,8 @@ const struct cmd_entry cmd_show_messages_entry = {
 	.name = "show-messages",
 	.alias = "showmsgs",
 
-	.args = { "JTt:", 0, 0, NULL },
-	.usage = "[-JT] " CMD_TARGET_CLIENT_USAGE,
+	.args = { "JLTt:", 0, 0, NULL },
+	.usage = "[-JLT] " CMD_TARGET_CLIENT_USAGE,
 
 	.flags = CMD_AFTERHOOK|CMD_CLIENT_TFLAG|CMD_CLIENT_CANFAIL,
 	.exec = cmd_show_messages_exec
@@ -86,6 +86,11 @@ cmd_show_messages_exec(struct cmd *self, struct cmdq_item *item)
 	}
 	if (args_has(args, 'J')) {
 		job_print_summary(item, blank);
+		format_job_print_summary(item, 0);
+		done = 1;
+	}
+	if (args_has(args, 'L')) {
+		log_print_buffer(item, done);
 		done = 1;
 	}
 	if (done)
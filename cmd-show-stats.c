@@ -0,0 +1,50 @@
+/* $OpenBSD$ */
+
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF MIND, USE, DATA OR PROFITS, WHETHER
+ * IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING
+ * OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+
+#include "tmux.h"
+
+/*
+ * Show server statistics.
+ */
+
+static enum cmd_retval	cmd_show_stats_exec(struct cmd *, struct cmdq_item *);
+
+const struct cmd_entry cmd_show_stats_entry = {
+	.name = "show-stats",
+	.alias = NULL,
+
+	.args = { "m", 0, 0, NULL },
+	.usage = "[-m]",
+
+	.flags = CMD_AFTERHOOK,
+	.exec = cmd_show_stats_exec
+};
+
+static enum cmd_retval
+cmd_show_stats_exec(struct cmd *self, struct cmdq_item *item)
+{
+	struct args	*args = cmd_get_args(self);
+
+	if (args_has(args, 'm'))
+		stats_print_memory(item);
+	else
+		stats_print(item);
+	return (CMD_RETURN_NORMAL);
+}
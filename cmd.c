@@ -107,6 +107,7 @@ extern const struct cmd_entry cmd_show_hooks_entry;
 extern const struct cmd_entry cmd_show_messages_entry;
 extern const struct cmd_entry cmd_show_options_entry;
 extern const struct cmd_entry cmd_show_prompt_history_entry;
+extern const struct cmd_entry cmd_show_stats_entry;
 extern const struct cmd_entry cmd_show_window_options_entry;
 extern const struct cmd_entry cmd_source_file_entry;
 extern const struct cmd_entry cmd_split_window_entry;
@@ -201,6 +202,7 @@ const struct cmd_entry *cmd_table[] = {
 	&cmd_show_messages_entry,
 	&cmd_show_options_entry,
 	&cmd_show_prompt_history_entry,
+	&cmd_show_stats_entry,
 	&cmd_show_window_options_entry,
 	&cmd_source_file_entry,
 	&cmd_split_window_entry,
@@ -460,9 +460,12 @@ int		 utf8proc_mbtowc(wchar_t *, const char *, size_t);
 int		 utf8proc_wctomb(char *, wchar_t);
 #endif
 
-#ifdef NEED_FUZZING
+#if defined(NEED_FUZZING) || defined(NEED_BENCHMARKS)
 /* tmux.c */
 #define main __weak main
+#endif
+
+#ifdef NEED_FUZZING
 #define regcomp(preg, pattern, cflags) (0)
 #define regexec(preg, string, nmatch, pmatch, eflags) (REG_NOMATCH)
 #define regfree(preg) ((void)0)
@@ -753,7 +753,7 @@ control_start(struct client *c)
 	TAILQ_INIT(&cs->all_blocks);
 	cs->subs = monitor_create_client(c, control_sub_change, NULL);
 
-	cs->read_event = bufferevent_new(c->fd, control_read_callback,
+	cs->read_event = proc_bufferevent_new(c->fd, control_read_callback,
 	    control_write_callback, control_error_callback, c);
 	if (cs->read_event == NULL)
 		fatalx("out of memory");
@@ -761,7 +761,7 @@ control_start(struct client *c)
 	if (c->flags & CLIENT_CONTROLCONTROL)
 		cs->write_event = cs->read_event;
 	else {
-		cs->write_event = bufferevent_new(c->out_fd, NULL,
+		cs->write_event = proc_bufferevent_new(c->out_fd, NULL,
 		    control_write_callback, control_error_callback, c);
 		if (cs->write_event == NULL)
 			fatalx("out of memory");
@@ -615,7 +615,7 @@ file_write_open(struct client_files *files, struct tmuxpeer *peer,
 		goto reply;
 	}
 
-	cf->event = bufferevent_new(cf->fd, NULL, file_write_callback,
+	cf->event = proc_bufferevent_new(cf->fd, NULL, file_write_callback,
 	    file_write_error_callback, cf);
 	if (cf->event == NULL)
 		fatalx("out of memory");
@@ -776,7 +776,7 @@ file_read_open(struct client_files *files, struct tmuxpeer *peer,
 		goto reply;
 	}
 
-	cf->event = bufferevent_new(cf->fd, file_read_callback, NULL,
+	cf->event = proc_bufferevent_new(cf->fd, file_read_callback, NULL,
 	    file_read_error_callback, cf);
 	if (cf->event == NULL)
 		fatalx("out of memory");
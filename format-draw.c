@@ -708,7 +708,7 @@ format_draw(struct screen_write_ctx *octx, const struct grid_cell *base,
 					     "LIST_LEFT",
 					     "LIST_RIGHT",
 					     "AFTER" };
-	size_t			 size = strlen(expanded);
+	size_t			 size = strlen(expanded), span;
 	struct screen		*os = octx->s, s[TOTAL];
 	struct hyperlinks	*hl = os->hyperlinks;
 	struct screen_write_ctx	 ctx[TOTAL];
@@ -789,6 +789,19 @@ format_draw(struct screen_write_ctx *octx, const struct grid_cell *base,
 
 		/* Is this not a style? */
 		if (cp[0] != '#' || cp[1] != '[' || sy.ignore) {
+			/* Draw any run of printable ASCII directly. */
+			span = utf8_ascii_span(cp, size - (cp - expanded), '#');
+			if (span != 0) {
+				utf8_set(ud, *cp);
+				for (n = 0; n < span; n++) {
+					ud->data[0] = cp[n];
+					screen_write_cell(&ctx[current], &sy.gc);
+				}
+				width[current] += span;
+				cp += span;
+				continue;
+			}
+
 			/* See if this is a UTF-8 character. */
 			if ((more = utf8_open(ud, *cp)) == UTF8_MORE) {
 				while (*++cp != '\0' && more == UTF8_MORE)
@@ -1099,13 +1112,20 @@ out:
 u_int
 format_width(const char *expanded)
 {
-	const char		*cp, *end;
+	const char		*cp, *end, *last = expanded + strlen(expanded);
 	u_int			 n, leading_width, width = 0;
 	struct utf8_data	 ud;
 	enum utf8_state		 more;
+	size_t			 span;
 
 	cp = expanded;
 	while (*cp != '\0') {
+		span = utf8_ascii_span(cp, last - cp, '#');
+		if (span != 0) {
+			width += span;
+			cp += span;
+			continue;
+		}
 		if (*cp == '#') {
 			end = format_leading_hashes(cp, &n, &leading_width);
 			width += leading_width;
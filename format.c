@@ -42,6 +42,7 @@
 struct format_expand_state;
 
 static char	*format_job_get(struct format_expand_state *, const char *);
+static void	 format_job_complete(struct job *);
 static char	*format_quote_shell_single(const char *);
 static char	*format_expand1(struct format_expand_state *, const char *);
 static int	 format_replace(struct format_expand_state *, const char *,
@@ -52,6 +53,37 @@ static void	 format_defaults_client(struct format_tree *, struct client *);
 static void	 format_defaults_winlink(struct format_tree *,
 		     struct winlink *);
 
+/*
+ * A format job command. Identical commands with the same working directory
+ * share one of these between all clients and trees, so each is run once
+ * however many status lines use it.
+ */
+struct format_job_run {
+	char			*cmd;
+	char			*cwd;
+
+	struct job		*job;
+	int			 queued;
+	u_int			 phase;
+	time_t			 interval;
+	time_t			 used;
+	time_t			 last;
+	time_t			 notified;
+	uint64_t		 started;
+	char			*out;
+	int			 updated;
+
+	u_int			 runs;
+	u_int			 failed;
+	uint64_t		 last_time;
+	uint64_t		 total_time;
+	uint64_t		 max_time;
+
+	LIST_HEAD(, format_job)	 users;
+	TAILQ_ENTRY(format_job_run) queue_entry;
+	RB_ENTRY(format_job_run) entry;
+};
+
 /* Entry in format job tree. */
 struct format_job {
 	struct client		*client;
@@ -60,12 +92,11 @@ struct format_job {
 	const char		*expanded;
 
 	time_t			 last;
-	char			*out;
-	int			 updated;
-
-	struct job		*job;
 	int			 status;
 
+	struct format_job_run	*run;
+	LIST_ENTRY(format_job)	 run_entry;
+
 	RB_ENTRY(format_job)	 entry;
 };
 
@@ -74,6 +105,23 @@ static int format_job_cmp(struct format_job *, struct format_job *);
 static RB_HEAD(format_job_tree, format_job) format_jobs = RB_INITIALIZER();
 RB_GENERATE_STATIC(format_job_tree, format_job, entry, format_job_cmp);
 
+/* Format job command tree. */
+static int format_job_run_cmp(struct format_job_run *,
+    struct format_job_run *);
+static RB_HEAD(format_job_run_tree, format_job_run) format_job_runs =
+    RB_INITIALIZER();
+RB_GENERATE_STATIC(format_job_run_tree, format_job_run, entry,
+    format_job_run_cmp);
+
+/* Format job commands waiting for a free slot. */
+static TAILQ_HEAD(, format_job_run) format_job_queue =
+    TAILQ_HEAD_INITIALIZER(format_job_queue);
+static u_int format_job_running;
+static struct event format_job_timer;
+
+/* Maximum number of format jobs running at once. */
+#define FORMAT_JOB_MAX_RUNNING 16
+
 /* Format job tree comparison function. */
 static int
 format_job_cmp(struct format_job *fj1, struct format_job *fj2)
@@ -85,6 +133,17 @@ format_job_cmp(struct format_job *fj1, struct format_job *fj2)
 	return (strcmp(fj1->cmd, fj2->cmd));
 }
 
+/* Format job command tree comparison function. */
+static int
+format_job_run_cmp(struct format_job_run *fr1, struct format_job_run *fr2)
+{
+	int	result;
+
+	if ((result = strcmp(fr1->cmd, fr2->cmd)) != 0)
+		return (result);
+	return (strcmp(fr1->cwd, fr2->cwd));
+}
+
 /* Maimum pad and trim width. */
 #define FORMAT_MAX_WIDTH 10000
 
@@ -315,11 +374,27 @@ format_copy_state(struct format_expand_state *to,
 	to->start_time = from->start_time;
 }
 
+/* Tell the clients using a format job that it has new output. */
+static void
+format_job_notify(struct format_job_run *fr, int complete)
+{
+	struct format_job	*fj;
+
+	LIST_FOREACH(fj, &fr->users, run_entry) {
+		if (!fj->status)
+			continue;
+		if (fj->client != NULL)
+			server_status_client(fj->client);
+		if (complete)
+			fj->status = 0;
+	}
+}
+
 /* Format job update callback. */
 static void
 format_job_update(struct job *job)
 {
-	struct format_job	*fj = job_get_data(job);
+	struct format_job_run	*fr = job_get_data(job);
 	struct evbuffer		*evb = job_get_event(job)->input;
 	char			*line = NULL, *next;
 	time_t			 t;
@@ -330,18 +405,89 @@ format_job_update(struct job *job)
 	}
 	if (line == NULL)
 		return;
-	fj->updated = 1;
+	fr->updated = 1;
 
-	free(fj->out);
-	fj->out = line;
+	free(fr->out);
+	fr->out = line;
 
-	log_debug("%s: %p %s: %s", __func__, fj, fj->cmd, fj->out);
+	log_debug("%s: %p %s: %s", __func__, fr, fr->cmd, fr->out);
 
 	t = time(NULL);
-	if (fj->status && fj->last != t) {
-		if (fj->client != NULL)
-			server_status_client(fj->client);
-		fj->last = t;
+	if (fr->notified != t) {
+		format_job_notify(fr, 0);
+		fr->notified = t;
+	}
+}
+
+/* Start a format job. */
+static void
+format_job_start(struct format_job_run *fr)
+{
+	fr->job = job_run(fr->cmd, 0, NULL, NULL, NULL, fr->cwd,
+	    format_job_update, format_job_complete, NULL, fr, JOB_NOWAIT, -1,
+	    -1);
+	if (fr->job == NULL) {
+		free(fr->out);
+		xasprintf(&fr->out, "<'%s' didn't start>", fr->cmd);
+		fr->failed++;
+	} else {
+		format_job_running++;
+		fr->started = get_timer();
+		fr->runs++;
+	}
+	fr->last = time(NULL);
+	fr->updated = 0;
+}
+
+/* Start waiting format jobs while there is room. */
+static void
+format_job_drain(void)
+{
+	struct format_job_run	*fr;
+
+	while (format_job_running < FORMAT_JOB_MAX_RUNNING) {
+		fr = TAILQ_FIRST(&format_job_queue);
+		if (fr == NULL)
+			break;
+		TAILQ_REMOVE(&format_job_queue, fr, queue_entry);
+		fr->queued = 0;
+
+		log_debug("%s: %p %s", __func__, fr, fr->cmd);
+		format_job_start(fr);
+	}
+}
+
+/* Start a format job or queue it if too many are running. */
+static void
+format_job_schedule(struct format_job_run *fr)
+{
+	if (fr->queued)
+		return;
+	if (format_job_running < FORMAT_JOB_MAX_RUNNING &&
+	    TAILQ_EMPTY(&format_job_queue)) {
+		format_job_start(fr);
+		return;
+	}
+	log_debug("%s: %p %s: queued (%u running)", __func__, fr, fr->cmd,
+	    format_job_running);
+	TAILQ_INSERT_TAIL(&format_job_queue, fr, queue_entry);
+	fr->queued = 1;
+	fr->last = time(NULL);
+}
+
+/* Stop a running or waiting format job. */
+static void
+format_job_stop(struct format_job_run *fr)
+{
+	if (fr->queued) {
+		TAILQ_REMOVE(&format_job_queue, fr, queue_entry);
+		fr->queued = 0;
+	}
+	if (fr->job != NULL) {
+		job_free(fr->job);
+		fr->job = NULL;
+		format_job_running--;
+		format_job_drain();
 	}
 }
 
@@ -349,12 +495,20 @@ format_job_update(struct job *job)
 static void
 format_job_complete(struct job *job)
 {
-	struct format_job	*fj = job_get_data(job);
+	struct format_job_run	*fr = job_get_data(job);
 	struct evbuffer		*evb = job_get_event(job)->input;
 	char			*line, *buf;
 	size_t			 len;
+	uint64_t		 elapsed;
+
+	fr->job = NULL;
+	format_job_running--;
 
-	fj->job = NULL;
+	elapsed = get_timer() - fr->started;
+	fr->last_time = elapsed;
+	fr->total_time += elapsed;
+	if (elapsed > fr->max_time)
+		fr->max_time = elapsed;
 
 	buf = NULL;
 	if ((line = evbuffer_readline(evb)) == NULL) {
@@ -366,19 +520,128 @@ format_job_complete(struct job *job)
 	} else
 		buf = line;
 
-	log_debug("%s: %p %s: %s", __func__, fj, fj->cmd, buf);
+	log_debug("%s: %p %s: %s (%llu ms)", __func__, fr, fr->cmd, buf,
+	    (unsigned long long)elapsed);
 
-	if (*buf != '\0' || !fj->updated) {
-		free(fj->out);
-		fj->out = buf;
+	if (*buf != '\0' || !fr->updated) {
+		free(fr->out);
+		fr->out = buf;
 	} else
 		free(buf);
 
-	if (fj->status) {
-		if (fj->client != NULL)
-			server_status_client(fj->client);
-		fj->status = 0;
+	format_job_notify(fr, 1);
+	format_job_drain();
+}
+
+/* Find or create the shared command for a format job. */
+static struct format_job_run *
+format_job_get_run(const char *cmd, const char *cwd)
+{
+	struct format_job_run	 fr0, *fr;
+	const char		*cp;
+
+	fr0.cmd = (char *)cmd;
+	fr0.cwd = (char *)cwd;
+	if ((fr = RB_FIND(format_job_run_tree, &format_job_runs, &fr0)) != NULL)
+		return (fr);
+
+	fr = xcalloc(1, sizeof *fr);
+	fr->cmd = xstrdup(cmd);
+	fr->cwd = xstrdup(cwd);
+
+	/* Pick a phase from the command so refreshes are spread out. */
+	fr->phase = 2166136261U;
+	for (cp = cmd; *cp != '\0'; cp++)
+		fr->phase = (fr->phase ^ (u_char)*cp) * 16777619U;
+	LIST_INIT(&fr->users);
+	RB_INSERT(format_job_run_tree, &format_job_runs, fr);
+	return (fr);
+}
+
+/*
+ * Work out when a format job should next run. Each command runs every interval
+ * seconds at its own phase within the interval, so commands which first ran
+ * together do not keep running in the same second. The first run after that
+ * may be between half and one and a half intervals later.
+ */
+static time_t
+format_job_next(struct format_job_run *fr, time_t interval)
+{
+	time_t	next, phase;
+
+	if (interval <= 1)
+		return (fr->last + 1);
+	next = fr->last + interval / 2;
+	phase = fr->phase % interval;
+	return (next + (phase - next % interval + interval) % interval);
+}
+
+/*
+ * Format job timer. Start any jobs used by a status line which are due, so
+ * they run at their own time rather than when the status line is redrawn.
+ * Jobs not used for more than two intervals are left until they are used
+ * again.
+ */
+static void
+format_job_timer_callback(__unused int fd, __unused short events,
+    __unused void *arg)
+{
+	struct format_job_run	*fr;
+	struct format_job	*fj;
+	struct timeval		 tv = { .tv_sec = 1 };
+	time_t			 t = time(NULL);
+	int			 active = 0;
+
+	RB_FOREACH(fr, format_job_run_tree, &format_job_runs) {
+		if (fr->interval <= 1 || t - fr->used > fr->interval * 2)
+			continue;
+		active = 1;
+		if (fr->job != NULL || fr->queued || fr->last > t)
+			continue;
+		if (t < format_job_next(fr, fr->interval))
+			continue;
+
+		log_debug("%s: %p %s", __func__, fr, fr->cmd);
+		LIST_FOREACH(fj, &fr->users, run_entry)
+			fj->status = 1;
+		format_job_schedule(fr);
 	}
+	if (active)
+		evtimer_add(&format_job_timer, &tv);
+}
+
+/* Start the format job timer if it is not running. */
+static void
+format_job_start_timer(void)
+{
+	struct timeval	tv = { .tv_sec = 1 };
+
+	if (!event_initialized(&format_job_timer))
+		evtimer_set(&format_job_timer, format_job_timer_callback, NULL);
+	if (!evtimer_pending(&format_job_timer, NULL))
+		evtimer_add(&format_job_timer, &tv);
+}
+
+/* Stop using a shared command and free it if nothing else is. */
+static void
+format_job_release(struct format_job *fj)
+{
+	struct format_job_run	*fr = fj->run;
+
+	if (fr == NULL)
+		return;
+	fj->run = NULL;
+	LIST_REMOVE(fj, run_entry);
+	if (!LIST_EMPTY(&fr->users))
+		return;
+
+	log_debug("%s: %s", __func__, fr->cmd);
+	format_job_stop(fr);
+	RB_REMOVE(format_job_run_tree, &format_job_runs, fr);
+	free(fr->cmd);
+	free(fr->cwd);
+	free(fr->out);
+	free(fr);
 }
 
 /* Find a job. */
@@ -388,9 +651,11 @@ format_job_get(struct format_expand_state *es, const char *cmd)
 	struct format_tree		*ft = es->ft;
 	struct format_job_tree		*jobs;
 	struct format_job		 fj0, *fj;
-	time_t				 t;
+	struct format_job_run		*fr;
+	struct session			*s;
+	time_t				 t, interval = 1;
 	char				*expanded;
-	int				 force;
+	const char			*cwd;
 	struct format_expand_state	 next;
 
 	if (ft->client == NULL)
@@ -417,35 +682,56 @@ format_job_get(struct format_expand_state *es, const char *cmd)
 	next.flags &= ~FORMAT_EXPAND_TIME;
 
 	expanded = format_expand1(&next, cmd);
-	if (fj->expanded == NULL || strcmp(expanded, fj->expanded) != 0) {
+	cwd = server_client_get_cwd(ft->client, NULL);
+	if (fj->run == NULL ||
+	    strcmp(expanded, fj->expanded) != 0 ||
+	    strcmp(cwd, fj->run->cwd) != 0) {
+		format_job_release(fj);
 		free((void *)fj->expanded);
 		fj->expanded = xstrdup(expanded);
-		force = 1;
-	} else
-		force = (ft->flags & FORMAT_FORCE);
 
-	t = time(NULL);
-	if (force && fj->job != NULL)
-	       job_free(fj->job);
-	if (force || (fj->job == NULL && fj->last != t)) {
-		fj->job = job_run(expanded, 0, NULL, NULL, NULL,
-		    server_client_get_cwd(ft->client, NULL), format_job_update,
-		    format_job_complete, NULL, fj, JOB_NOWAIT, -1, -1);
-		if (fj->job == NULL) {
-			free(fj->out);
-			xasprintf(&fj->out, "<'%s' didn't start>", fj->cmd);
-		}
-		fj->last = t;
-		fj->updated = 0;
-	} else if (fj->job != NULL && (t - fj->last) > 1 && fj->out == NULL)
-		xasprintf(&fj->out, "<'%s' not ready>", fj->cmd);
+		fj->run = format_job_get_run(expanded, cwd);
+		LIST_INSERT_HEAD(&fj->run->users, fj, run_entry);
+	}
+	fr = fj->run;
 	free(expanded);
 
+	/*
+	 * Jobs used by a status line are shared between clients, so only run
+	 * them again once per status interval rather than every time a client
+	 * redraws.
+	 */
+	if ((ft->flags & FORMAT_STATUS) && ft->client != NULL) {
+		s = ft->client->session;
+		if (s != NULL)
+			interval = options_get_number(s->options,
+			    "status-interval");
+		if (interval < 1)
+			interval = 1;
+		fr->interval = interval;
+		fr->used = time(NULL);
+		if (interval > 1)
+			format_job_start_timer();
+	}
+
+	t = time(NULL);
+	if ((ft->flags & FORMAT_FORCE) && fr->job != NULL)
+		format_job_stop(fr);
+	if (fr->job == NULL && !fr->queued) {
+		if ((ft->flags & FORMAT_FORCE) ||
+		    fr->last == 0 ||
+		    fr->last > t ||
+		    t >= format_job_next(fr, interval))
+			format_job_schedule(fr);
+	} else if (fr->job != NULL && (t - fr->last) > 1 && fr->out == NULL)
+		xasprintf(&fr->out, "<'%s' not ready>", fj->cmd);
+	fj->last = t;
+
 	if (ft->flags & FORMAT_STATUS)
 		fj->status = 1;
-	if (fj->out == NULL)
+	if (fr->out == NULL)
 		return (xstrdup(""));
-	return (format_expand1(&next, fj->out));
+	return (format_expand1(&next, fr->out));
 }
 
 /* Remove old jobs. */
@@ -463,17 +749,52 @@ format_job_tidy(struct format_job_tree *jobs, int force)
 
 		log_debug("%s: %s", __func__, fj->cmd);
 
-		if (fj->job != NULL)
-			job_free(fj->job);
+		format_job_release(fj);
 
 		free((void *)fj->expanded);
 		free((void *)fj->cmd);
-		free(fj->out);
 
 		free(fj);
 	}
 }
 
+/* Print format job statistics. */
+void
+format_job_print_summary(struct cmdq_item *item, int blank)
+{
+	struct format_job_run	*fr;
+	struct format_job	*fj;
+	const char		*state;
+	u_int			 n = 0, users;
+	uint64_t		 average;
+
+	RB_FOREACH(fr, format_job_run_tree, &format_job_runs) {
+		if (blank) {
+			cmdq_print(item, "%s", "");
+			blank = 0;
+		}
+		users = 0;
+		LIST_FOREACH(fj, &fr->users, run_entry)
+			users++;
+		if (fr->job != NULL)
+			state = "running";
+		else if (fr->queued)
+			state = "queued";
+		else
+			state = "idle";
+		average = 0;
+		if (fr->runs != 0)
+			average = fr->total_time / fr->runs;
+		cmdq_print(item, "Format job %u: %s [cwd=%s, %s, users=%u, "
+		    "runs=%u, failed=%u, last=%llums, average=%llums, "
+		    "maximum=%llums]", n, fr->cmd, fr->cwd, state, users,
+		    fr->runs, fr->failed, (unsigned long long)fr->last_time,
+		    (unsigned long long)average,
+		    (unsigned long long)fr->max_time);
+		n++;
+	}
+}
+
 /* Work around needless -Wformat-nonliteral gcc warning. */
 #ifdef __GNUC__
 #pragma GCC diagnostic push
@@ -933,14 +1254,16 @@ static void *
 format_cb_current_command(struct format_tree *ft)
 {
 	struct window_pane	*wp = ft->wp;
+	const char		*name;
 	char			*cmd, *value;
 
 	if (wp == NULL || wp->shell == NULL)
 		return (NULL);
 
-	cmd = osdep_get_name(wp->fd, wp->tty);
-	if (cmd == NULL || *cmd == '\0') {
-		free(cmd);
+	name = window_pane_current_command(wp);
+	if (name != NULL && *name != '\0')
+		cmd = xstrdup(name);
+	else {
 		cmd = cmd_stringify_argv(wp->argc, wp->argv);
 		if (cmd == NULL || *cmd == '\0') {
 			free(cmd);
@@ -957,12 +1280,12 @@ static void *
 format_cb_current_path(struct format_tree *ft)
 {
 	struct window_pane	*wp = ft->wp;
-	char			*cwd;
+	const char		*cwd;
 
 	if (wp == NULL)
 		return (NULL);
 
-	cwd = osdep_get_cwd(wp->fd);
+	cwd = window_pane_current_path(wp);
 	if (cwd == NULL)
 		return (NULL);
 	return (xstrdup(cwd));
@@ -1757,6 +2080,28 @@ format_cb_client_written(struct format_tree *ft)
 	return (NULL);
 }
 
+/* Callback for client_redraws. */
+static void *
+format_cb_client_redraws(struct format_tree *ft)
+{
+	if (ft->c != NULL) {
+		return (format_printf("%llu",
+		    (unsigned long long)ft->c->redraws));
+	}
+	return (NULL);
+}
+
+/* Callback for client_full_redraws. */
+static void *
+format_cb_client_full_redraws(struct format_tree *ft)
+{
+	if (ft->c != NULL) {
+		return (format_printf("%llu",
+		    (unsigned long long)ft->c->full_redraws));
+	}
+	return (NULL);
+}
+
 /* Callback for client_theme. */
 static void *
 format_cb_client_theme(struct format_tree *ft)
@@ -2337,6 +2682,28 @@ format_cb_pane_input_off(struct format_tree *ft)
 	return (NULL);
 }
 
+/* Callback for pane_input_bytes. */
+static void *
+format_cb_pane_input_bytes(struct format_tree *ft)
+{
+	if (ft->wp != NULL) {
+		return (format_printf("%llu",
+		    (unsigned long long)ft->wp->input_bytes));
+	}
+	return (NULL);
+}
+
+/* Callback for pane_cells_written. */
+static void *
+format_cb_pane_cells_written(struct format_tree *ft)
+{
+	if (ft->wp != NULL) {
+		return (format_printf("%llu",
+		    (unsigned long long)ft->wp->cells_written));
+	}
+	return (NULL);
+}
+
 /* Callback for pane_unseen_changes. */
 static void *
 format_cb_pane_unseen_changes(struct format_tree *ft)
@@ -2843,6 +3210,40 @@ format_cb_session_windows(struct format_tree *ft)
 	return (NULL);
 }
 
+/* Callback for session_input_bytes. */
+static void *
+format_cb_session_input_bytes(struct format_tree *ft)
+{
+	struct winlink		*wl;
+	struct window_pane	*wp;
+	uint64_t		 n = 0;
+
+	if (ft->s == NULL)
+		return (NULL);
+	RB_FOREACH(wl, winlinks, &ft->s->windows) {
+		TAILQ_FOREACH(wp, &wl->window->panes, entry)
+			n += wp->input_bytes;
+	}
+	return (format_printf("%llu", (unsigned long long)n));
+}
+
+/* Callback for session_cells_written. */
+static void *
+format_cb_session_cells_written(struct format_tree *ft)
+{
+	struct winlink		*wl;
+	struct window_pane	*wp;
+	uint64_t		 n = 0;
+
+	if (ft->s == NULL)
+		return (NULL);
+	RB_FOREACH(wl, winlinks, &ft->s->windows) {
+		TAILQ_FOREACH(wp, &wl->window->panes, entry)
+			n += wp->cells_written;
+	}
+	return (format_printf("%llu", (unsigned long long)n));
+}
+
 /* Callback for socket_path. */
 static void *
 format_cb_socket_path(__unused struct format_tree *ft)
@@ -3420,6 +3821,9 @@ static const struct format_table_entry format_table[] = {
 	{ "client_flags", FORMAT_TABLE_STRING,
 	  format_cb_client_flags
 	},
+	{ "client_full_redraws", FORMAT_TABLE_STRING,
+	  format_cb_client_full_redraws
+	},
 	{ "client_height", FORMAT_TABLE_STRING,
 	  format_cb_client_height
 	},
@@ -3444,6 +3848,9 @@ static const struct format_table_entry format_table[] = {
 	{ "client_readonly", FORMAT_TABLE_STRING,
 	  format_cb_client_readonly
 	},
+	{ "client_redraws", FORMAT_TABLE_STRING,
+	  format_cb_client_redraws
+	},
 	{ "client_session", FORMAT_TABLE_STRING,
 	  format_cb_client_session
 	},
@@ -3603,6 +4010,9 @@ static const struct format_table_entry format_table[] = {
 	{ "pane_bottom", FORMAT_TABLE_STRING,
 	  format_cb_pane_bottom
 	},
+	{ "pane_cells_written", FORMAT_TABLE_STRING,
+	  format_cb_pane_cells_written
+	},
 	{ "pane_command_duration", FORMAT_TABLE_STRING,
 	  format_cb_pane_command_duration
 	},
@@ -3660,6 +4070,9 @@ static const struct format_table_entry format_table[] = {
 	{ "pane_index", FORMAT_TABLE_STRING,
 	  format_cb_pane_index
 	},
+	{ "pane_input_bytes", FORMAT_TABLE_STRING,
+	  format_cb_pane_input_bytes
+	},
 	{ "pane_input_off", FORMAT_TABLE_STRING,
 	  format_cb_pane_input_off
 	},
@@ -3789,6 +4202,9 @@ static const struct format_table_entry format_table[] = {
 	{ "session_bell_flag", FORMAT_TABLE_STRING,
 	  format_cb_session_bell_flag
 	},
+	{ "session_cells_written", FORMAT_TABLE_STRING,
+	  format_cb_session_cells_written
+	},
 	{ "session_created", FORMAT_TABLE_TIME,
 	  format_cb_session_created
 	},
@@ -3819,6 +4235,9 @@ static const struct format_table_entry format_table[] = {
 	{ "session_id", FORMAT_TABLE_STRING,
 	  format_cb_session_id
 	},
+	{ "session_input_bytes", FORMAT_TABLE_STRING,
+	  format_cb_session_input_bytes
+	},
 	{ "session_last_attached", FORMAT_TABLE_TIME,
 	  format_cb_session_last_attached
 	},
@@ -6539,12 +6958,16 @@ char *
 format_expand_time(struct format_tree *ft, const char *fmt)
 {
 	struct format_expand_state	es;
+	uint64_t			t = stats_time();
+	char				*expanded;
 
 	memset(&es, 0, sizeof es);
 	es.ft = ft;
 	es.flags = FORMAT_EXPAND_TIME;
 	es.start_time = get_timer();
-	return (format_expand1(&es, fmt));
+	expanded = format_expand1(&es, fmt);
+	stats_add_time(&global_stats.format_time, t);
+	return (expanded);
 }
 
 /* Expand keys in a template. */
@@ -6552,12 +6975,16 @@ char *
 format_expand(struct format_tree *ft, const char *fmt)
 {
 	struct format_expand_state	es;
+	uint64_t			t = stats_time();
+	char				*expanded;
 
 	memset(&es, 0, sizeof es);
 	es.ft = ft;
 	es.flags = 0;
 	es.start_time = get_timer();
-	return (format_expand1(&es, fmt));
+	expanded = format_expand1(&es, fmt);
+	stats_add_time(&global_stats.format_time, t);
+	return (expanded);
 }
 
 /* Expand a single string. */
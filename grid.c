@@ -38,6 +38,15 @@
  * functions which work on the screen data.
  */
 
+/*
+ * Minimum number of history lines left for later when reflowing a grid with
+ * GRID_LAZYREFLOW.
+ */
+#define GRID_REFLOW_LAZY 1000
+
+/* All grids, so UTF-8 characters they use can be found. */
+static TAILQ_HEAD(, grid) grids = TAILQ_HEAD_INITIALIZER(grids);
+
 /* Default grid cell data. */
 const struct grid_cell grid_default_cell = {
 	{ { ' ' }, 0, 1, 1 }, 0, 0, 8, 8, 8, 0
@@ -153,8 +162,8 @@ grid_get_extended_cell(struct grid_line *gl, struct grid_cell_entry *gce,
 
 /* Set cell as extended. */
 static struct grid_extd_entry *
-grid_extended_cell(struct grid_line *gl, struct grid_cell_entry *gce,
-    const struct grid_cell *gc)
+grid_extended_cell(struct grid *gd, struct grid_line *gl,
+    struct grid_cell_entry *gce, const struct grid_cell *gc)
 {
 	struct grid_extd_entry	*gee;
 	int			 flags = (gc->flags & ~GRID_FLAG_CLEARED);
@@ -170,8 +179,10 @@ grid_extended_cell(struct grid_line *gl, struct grid_cell_entry *gce,
 
 	if (gc->flags & GRID_FLAG_TAB)
 		uc = gc->data.width;
+	else if (gd->flags & GRID_REFLOWTARGET)
+		utf8_find_grid_data(&gc->data, &uc);
 	else
-		utf8_from_data(&gc->data, &uc);
+		utf8_from_grid_data(&gc->data, &uc);
 
 	gee = &gl->extddata[gce->offset];
 	gee->data = uc;
@@ -254,13 +265,13 @@ grid_clear_cell(struct grid *gd, u_int px, u_int py, u_int bg, int moved)
 	if (!moved && had_extd && old_offset < gl->extdsize) {
 		gce->flags |= GRID_FLAG_EXTENDED;
 		gce->offset = old_offset;
-		gee = grid_extended_cell(gl, gce, &grid_cleared_cell);
+		gee = grid_extended_cell(gd, gl, gce, &grid_cleared_cell);
 		if (bg != 8)
 			gee->bg = bg;
 	} else if (bg != 8) {
 		if (bg & (COLOUR_FLAG_RGB|COLOUR_FLAG_THEME)) {
 			grid_get_extended_cell(gl, gce, gce->flags);
-			gee = grid_extended_cell(gl, gce, &grid_cleared_cell);
+			gee = grid_extended_cell(gd, gl, gce, &grid_cleared_cell);
 			gee->bg = bg;
 		} else {
 			if (bg & COLOUR_FLAG_256)
@@ -366,6 +377,8 @@ grid_create(u_int sx, u_int sy, u_int hlimit)
 	if (gd->sy != 0)
 		gd->linedata = xcalloc(gd->sy, sizeof *gd->linedata);
 
+	TAILQ_INSERT_TAIL(&grids, gd, entry);
+
 	grid_check_is_clear(gd);
 	return (gd);
 }
@@ -374,11 +387,69 @@ grid_create(u_int sx, u_int sy, u_int hlimit)
 void
 grid_destroy(struct grid *gd)
 {
+	TAILQ_REMOVE(&grids, gd, entry);
+
 	grid_free_lines(gd, 0, gd->hsize + gd->sy);
 	free(gd->linedata);
 	free(gd);
 }
 
+/* Mark the UTF-8 characters used by extended cells in all grids. */
+void
+grid_mark_utf8(void)
+{
+	struct grid		*gd;
+	struct grid_line	*gl;
+	u_int			 yy, i;
+
+	TAILQ_FOREACH(gd, &grids, entry) {
+		for (yy = 0; yy < gd->hsize + gd->sy; yy++) {
+			gl = &gd->linedata[yy];
+			for (i = 0; i < gl->extdsize; i++)
+				utf8_mark(gl->extddata[i].data);
+		}
+	}
+}
+
+/* Get the memory used by a grid's lines and cells in bytes. */
+size_t
+grid_memory(struct grid *gd)
+{
+	struct grid_line	*gl;
+	size_t			 size;
+	u_int			 yy;
+
+	size = sizeof *gd;
+	size += (gd->hsize + gd->sy) * sizeof *gd->linedata;
+	for (yy = 0; yy < gd->hsize + gd->sy; yy++) {
+		gl = &gd->linedata[yy];
+		size += gl->cellsize * sizeof *gl->celldata;
+		size += gl->extdsize * sizeof *gl->extddata;
+	}
+	return (size);
+}
+
+/*
+ * Free the oldest lines of history until at least size bytes are freed or the
+ * history is empty. Return the number of lines freed.
+ */
+u_int
+grid_free_history_memory(struct grid *gd, size_t size)
+{
+	struct grid_line	*gl;
+	size_t			 freed = 0;
+	u_int			 ny;
+
+	for (ny = 0; ny < gd->hsize && freed < size; ny++) {
+		gl = &gd->linedata[ny];
+		freed += sizeof *gl;
+		freed += gl->cellsize * sizeof *gl->celldata;
+		freed += gl->extdsize * sizeof *gl->extddata;
+	}
+	grid_free_history(gd, ny);
+	return (ny);
+}
+
 /* Compare grids. */
 int
 grid_compare(struct grid *ga, struct grid *gb)
@@ -439,12 +510,25 @@ grid_collect_history(struct grid *gd, int all)
 		ny = 1;
 	if (ny > gd->hsize)
 		ny = gd->hsize;
+	grid_free_history(gd, ny);
+}
+
+/* Free the oldest ny lines of history. */
+void
+grid_free_history(struct grid *gd, u_int ny)
+{
+	if (ny == 0 || ny > gd->hsize)
+		return;
 
 	/*
 	 * Free the lines from 0 to ny then move the remaining lines over
 	 * them.
 	 */
 	grid_trim_history(gd, ny);
+	if (gd->reflow_y > ny)
+		gd->reflow_y -= ny;
+	else
+		gd->reflow_y = 0;
 
 	gd->hsize -= ny;
 	gd->scroll_collected += ny;
@@ -460,6 +544,11 @@ grid_remove_history(struct grid *gd, u_int ny)
 
 	if (ny > gd->hsize)
 		return;
+	if (gd->reflow_y > gd->hsize - ny) {
+		grid_reflow_finish(gd);
+		if (ny > gd->hsize)
+			return;
+	}
 	start = gd->hsize + gd->sy - ny;
 	for (yy = 0; yy < ny; yy++)
 		grid_free_line(gd, start + yy);
@@ -496,6 +585,7 @@ grid_clear_history(struct grid *gd)
 
 	gd->hscrolled = 0;
 	gd->hsize = 0;
+	gd->reflow_y = 0;
 	gd->scroll_generation++;
 
 	gd->linedata = xreallocarray(gd->linedata, gd->sy,
@@ -653,7 +743,7 @@ grid_set_cell(struct grid *gd, u_int px, u_int py, const struct grid_cell *gc)
 
 	gce = &gl->celldata[px];
 	if (grid_need_extended_cell(gce, gc))
-		grid_extended_cell(gl, gce, gc);
+		grid_extended_cell(gd, gl, gce, gc);
 	else
 		grid_store_cell(gce, gc, gc->data.data[0]);
 }
@@ -687,7 +777,7 @@ grid_set_cells(struct grid *gd, u_int px, u_int py, const struct grid_cell *gc,
 	for (i = 0; i < slen; i++) {
 		gce = &gl->celldata[px + i];
 		if (grid_need_extended_cell(gce, gc)) {
-			gee = grid_extended_cell(gl, gce, gc);
+			gee = grid_extended_cell(gd, gl, gce, gc);
 			gee->data = utf8_build_one(s[i]);
 		} else
 			grid_store_cell(gce, gc, s[i]);
@@ -1497,25 +1587,35 @@ grid_reflow_split(struct grid *target, struct grid *gd, u_int sx, u_int yy,
 		grid_reflow_join(target, gd, sx, yy, width, 1);
 }
 
-/* Reflow lines on grid to new width. */
-void
-grid_reflow(struct grid *gd, u_int sx)
+/*
+ * Reflow lines from start to end on grid to new width. The lines before and
+ * after are moved across unchanged.
+ */
+static void
+grid_reflow_lines(struct grid *gd, u_int sx, u_int start, u_int end)
 {
-	struct grid		*target;
+	struct grid		 target0 = { .sx = gd->sx }, *target = &target0;
 	struct grid_line	*gl;
 	struct grid_cell	 gc;
-	u_int			 yy, width, i, at;
+	u_int			 yy, width, i, at, total = gd->hsize + gd->sy;
 
 	/*
-	 * Create a destination grid. This is just used as a container for the
-	 * line data and may not be fully valid.
+	 * Use a destination grid which is just a container for the line data
+	 * and may not be fully valid. It is not added to the list of grids,
+	 * because this may be run on a thread while the main thread waits (see
+	 * screen_reflow_end), so nothing outside the two grids may be changed -
+	 * this includes the UTF-8 table, so characters are only looked up.
 	 */
-	target = grid_create(gd->sx, 0, 0);
+	target->flags = GRID_REFLOWTARGET;
+	if (start != 0) {
+		gl = grid_reflow_add(target, start);
+		memcpy(gl, gd->linedata, start * sizeof *gl);
+	}
 
 	/*
 	 * Loop over each source line.
 	 */
-	for (yy = 0; yy < gd->hsize + gd->sy; yy++) {
+	for (yy = start; yy < end; yy++) {
 		gl = &gd->linedata[yy];
 		if (gl->flags & GRID_LINE_DEAD)
 			continue;
@@ -1568,6 +1668,10 @@ grid_reflow(struct grid *gd, u_int sx)
 		else
 			grid_reflow_move(target, gl);
 	}
+	if (end != total) {
+		gl = grid_reflow_add(target, total - end);
+		memcpy(gl, &gd->linedata[end], (total - end) * sizeof *gl);
+	}
 
 	/*
 	 * Replace the old grid with the new.
@@ -1579,10 +1683,52 @@ grid_reflow(struct grid *gd, u_int sx)
 		gd->hscrolled = gd->hsize;
 	free(gd->linedata);
 	gd->linedata = target->linedata;
-	free(target);
 	gd->scroll_generation++;
 }
 
+/*
+ * Reflow lines on grid to new width. If the grid allows it and has a large
+ * history, only the visible lines and a screen of history above them are
+ * reflowed now; the older history is left as it is until it is needed, see
+ * grid_reflow_finish. The unreflowed lines always end with a complete
+ * (unwrapped) line so no wrapped line is split between the two parts.
+ */
+void
+grid_reflow(struct grid *gd, u_int sx)
+{
+	u_int	start = 0;
+
+	if ((gd->flags & GRID_LAZYREFLOW) &&
+	    gd->hsize > GRID_REFLOW_LAZY + gd->sy) {
+		start = gd->hsize - gd->sy;
+		while (start != 0 &&
+		    (gd->linedata[start - 1].flags & GRID_LINE_WRAPPED))
+			start--;
+		if (start < GRID_REFLOW_LAZY)
+			start = 0;
+	}
+	if (start != 0) {
+		log_debug("%s: leaving %u of %u lines", __func__, start,
+		    gd->hsize + gd->sy);
+	}
+
+	grid_reflow_lines(gd, sx, start, gd->hsize + gd->sy);
+	gd->reflow_y = start;
+	gd->reflow_sx = sx;
+}
+
+/* Reflow any history left unreflowed by grid_reflow. */
+void
+grid_reflow_finish(struct grid *gd)
+{
+	if (gd->reflow_y == 0)
+		return;
+	log_debug("%s: reflowing %u lines", __func__, gd->reflow_y);
+
+	grid_reflow_lines(gd, gd->reflow_sx, 0, gd->reflow_y);
+	gd->reflow_y = 0;
+}
+
 /* Convert to position based on wrapped lines. */
 void
 grid_wrap_position(struct grid *gd, u_int px, u_int py, u_int *wx, u_int *wy)
@@ -201,6 +201,22 @@ hyperlinks_get(struct hyperlinks *hl, u_int inner, const char **uri_out,
 	return (1);
 }
 
+/* Get the memory used by a hyperlink set in bytes. */
+size_t
+hyperlinks_memory(struct hyperlinks *hl)
+{
+	struct hyperlinks_uri	*hlu;
+	size_t			 size = sizeof *hl;
+
+	RB_FOREACH(hlu, hyperlinks_by_inner_tree, &hl->by_inner) {
+		size += sizeof *hlu;
+		size += strlen(hlu->internal_id) + 1;
+		size += strlen(hlu->external_id) + 1;
+		size += strlen(hlu->uri) + 1;
+	}
+	return (size);
+}
+
 /* Initialize hyperlink set. */
 struct hyperlinks *
 hyperlinks_init(void)
@@ -26,10 +26,8 @@
 #define SIXEL_WIDTH_LIMIT 10000
 #define SIXEL_HEIGHT_LIMIT 10000
 
-struct sixel_line {
-	u_int		 x;
-	uint16_t	*data;
-};
+/* Largest image (in pixels) allocated up front from its raster attributes. */
+#define SIXEL_RESERVE_LIMIT (1024 * 1024)
 
 struct sixel_image {
 	u_int			 x;
@@ -50,7 +48,9 @@ struct sixel_image {
 	u_int			 dy;
 	u_int			 dc;
 
-	struct sixel_line	*lines;
+	uint16_t		*data;
+	u_int			 stride;
+	u_int			 rows;
 };
 
 struct sixel_chunk {
@@ -66,56 +66,114 @@ struct sixel_chunk {
 	char	*data;
 };
 
-static int
-sixel_parse_expand_lines(struct sixel_image *si, u_int y)
+/*
+ * Make sure there is space for x by y pixels. Pixels are kept in one block,
+ * stride entries to a row, and grown by doubling so an image without raster
+ * attributes is not copied for every new line. The block may be smaller than
+ * the image size, in which case the pixels outside it are unset.
+ */
+static void
+sixel_reserve(struct sixel_image *si, u_int x, u_int y)
 {
-	if (y <= si->y)
-		return (0);
-	if (y > SIXEL_HEIGHT_LIMIT)
-		return (1);
-	si->lines = xrecallocarray(si->lines, si->y, y, sizeof *si->lines);
-	si->y = y;
-	return (0);
+	uint16_t	*data;
+	u_int		 stride, rows, i;
+
+	if (x == 0)
+		x = 1;
+	if (y == 0)
+		y = 1;
+
+	rows = si->rows;
+	if (y > rows) {
+		rows *= 2;
+		if (rows < y)
+			rows = y;
+		if (rows > SIXEL_HEIGHT_LIMIT)
+			rows = SIXEL_HEIGHT_LIMIT;
+	}
+
+	if (x > si->stride) {
+		stride = si->stride * 2;
+		if (stride < x)
+			stride = x;
+		if (stride > SIXEL_WIDTH_LIMIT)
+			stride = SIXEL_WIDTH_LIMIT;
+		data = xcalloc((size_t)rows * stride, sizeof *data);
+		for (i = 0; i < si->rows; i++) {
+			memcpy(data + (size_t)i * stride,
+			    si->data + (size_t)i * si->stride,
+			    si->stride * sizeof *data);
+		}
+		free(si->data);
+		si->data = data;
+		si->stride = stride;
+	} else if (rows != si->rows) {
+		si->data = xrecallocarray(si->data,
+		    (size_t)si->rows * si->stride, (size_t)rows * si->stride,
+		    sizeof *si->data);
+	}
+	si->rows = rows;
 }
 
 static int
-sixel_parse_expand_line(struct sixel_image *si, struct sixel_line *sl, u_int x)
+sixel_grow(struct sixel_image *si, u_int x, u_int y)
 {
-	if (x <= sl->x)
-		return (0);
-	if (x > SIXEL_WIDTH_LIMIT)
+	if (x > SIXEL_WIDTH_LIMIT || y > SIXEL_HEIGHT_LIMIT)
 		return (1);
+	if (x > si->stride || y > si->rows)
+		sixel_reserve(si, x, y);
 	if (x > si->x)
 		si->x = x;
-	sl->data = xrecallocarray(sl->data, sl->x, si->x, sizeof *sl->data);
-	sl->x = si->x;
+	if (y > si->y)
+		si->y = y;
 	return (0);
 }
 
+/* Shrink the block to the image size once no more pixels will be set. */
+static void
+sixel_compact(struct sixel_image *si)
+{
+	uint16_t	*data;
+	u_int		 stride, rows, i;
+
+	stride = (si->x < si->stride) ? si->x : si->stride;
+	rows = (si->y < si->rows) ? si->y : si->rows;
+	if (stride == si->stride && rows == si->rows)
+		return;
+	if (stride == 0 || rows == 0) {
+		free(si->data);
+		si->data = NULL;
+		si->stride = si->rows = 0;
+		return;
+	}
+
+	data = xcalloc((size_t)rows * stride, sizeof *data);
+	for (i = 0; i < rows; i++) {
+		memcpy(data + (size_t)i * stride,
+		    si->data + (size_t)i * si->stride,
+		    stride * sizeof *data);
+	}
+	free(si->data);
+	si->data = data;
+	si->stride = stride;
+	si->rows = rows;
+}
+
 static u_int
 sixel_get_pixel(struct sixel_image *si, u_int x, u_int y)
 {
-	struct sixel_line	*sl;
-
-	if (y >= si->y)
-		return (0);
-	sl = &si->lines[y];
-	if (x >= sl->x)
+	if (x >= si->x || y >= si->y || x >= si->stride || y >= si->rows)
 		return (0);
-	return (sl->data[x]);
+	return (si->data[(size_t)y * si->stride + x]);
 }
 
 static int
 sixel_set_pixel(struct sixel_image *si, u_int x, u_int y, u_int c)
 {
-	struct sixel_line	*sl;
-
-	if (sixel_parse_expand_lines(si, y + 1) != 0)
+	if ((x >= si->x || y >= si->y || x >= si->stride || y >= si->rows) &&
+	    sixel_grow(si, x + 1, y + 1) != 0)
 		return (1);
-	sl = &si->lines[y];
-	if (sixel_parse_expand_line(si, sl, x + 1) != 0)
-		return (1);
-	sl->data[x] = c;
+	si->data[(size_t)y * si->stride + x] = c;
 	return (0);
 }
 
@@ -176,8 +234,21 @@ sixel_parse_attributes(struct sixel_image *si, const char *cp, const char *end)
 		return (NULL);
 	}
 
+	/*
+	 * Set the size. The raster attributes are not trusted, so the whole
+	 * image (rounding the height up to a full band of six rows) is only
+	 * allocated now if it is small; otherwise space is added as pixels are
+	 * set.
+	 */
 	si->x = x;
-	sixel_parse_expand_lines(si, y);
+	if (y > si->y)
+		si->y = y;
+	if ((size_t)x * y <= SIXEL_RESERVE_LIMIT) {
+		if (y % 6 != 0 && y - (y % 6) + 6 <= SIXEL_HEIGHT_LIMIT)
+			sixel_reserve(si, x, y - (y % 6) + 6);
+		else
+			sixel_reserve(si, x, y);
+	}
 
 	si->set_ra = 1;
 	si->ra_x = x;
@@ -290,22 +361,10 @@ sixel_parse_repeat(struct sixel_image *si, const char *cp, const char *end)
 	return (last);
 }
 
-struct sixel_image *
-sixel_parse(const char *buf, size_t len, u_int p2, u_int xpixel, u_int ypixel)
+static int
+sixel_parse_buffer(struct sixel_image *si, const char *cp, const char *end)
 {
-	struct sixel_image	*si;
-	const char		*cp = buf, *end = buf + len;
-	char			 ch;
-
-	if (len == 0 || len == 1 || *cp++ != 'q') {
-		log_debug("%s: empty image", __func__);
-		return (NULL);
-	}
-
-	si = xcalloc (1, sizeof *si);
-	si->xpixel = xpixel;
-	si->ypixel = ypixel;
-	si->p2 = p2;
+	char	ch;
 
 	while (cp != end) {
 		ch = *cp++;
@@ -313,17 +372,17 @@ sixel_parse(const char *buf, size_t len, u_int p2, u_int xpixel, u_int ypixel)
 		case '"':
 			cp = sixel_parse_attributes(si, cp, end);
 			if (cp == NULL)
-				goto bad;
+				return (1);
 			break;
 		case '#':
 			cp = sixel_parse_colour(si, cp, end);
 			if (cp == NULL)
-				goto bad;
+				return (1);
 			break;
 		case '!':
 			cp = sixel_parse_repeat(si, cp, end);
 			if (cp == NULL)
-				goto bad;
+				return (1);
 			break;
 		case '-':
 			si->dx = 0;
@@ -336,18 +395,63 @@ sixel_parse(const char *buf, size_t len, u_int p2, u_int xpixel, u_int ypixel)
 			if (ch < 0x20)
 				break;
 			if (ch < 0x3f || ch > 0x7e)
-				goto bad;
+				return (1);
 			if (sixel_parse_write(si, ch - 0x3f) != 0) {
 				log_debug("%s: width limit reached", __func__);
-				goto bad;
+				return (1);
 			}
 			si->dx++;
 			break;
 		}
 	}
+	return (0);
+}
+
+/* Start a new image, the data follows with sixel_parse_data. */
+struct sixel_image *
+sixel_parse_start(u_int p2, u_int xpixel, u_int ypixel)
+{
+	struct sixel_image	*si;
 
+	si = xcalloc (1, sizeof *si);
+	si->xpixel = xpixel;
+	si->ypixel = ypixel;
+	si->p2 = p2;
+	return (si);
+}
+
+/*
+ * Parse part of an image. Only complete commands are parsed, so a command
+ * split between two pieces is not misread: the number of bytes used is
+ * returned and the remainder should be passed again with the next piece.
+ */
+int
+sixel_parse_data(struct sixel_image *si, const char *buf, size_t len,
+    size_t *used)
+{
+	size_t	n = len;
+	char	ch;
+
+	while (n != 0) {
+		ch = buf[n - 1];
+		if (ch != '"' && ch != '#' && ch != '!' && ch != ';' &&
+		    (ch < '0' || ch > '9'))
+			break;
+		n--;
+	}
+	*used = n;
+	return (sixel_parse_buffer(si, buf, buf + n));
+}
+
+/* Parse the end of an image and check it. Frees the image on failure. */
+struct sixel_image *
+sixel_parse_end(struct sixel_image *si, const char *buf, size_t len)
+{
+	if (sixel_parse_buffer(si, buf, buf + len) != 0)
+		goto bad;
 	if (si->x == 0 || si->y == 0)
 		goto bad;
+	sixel_compact(si);
 	return (si);
 
 bad:
@@ -355,15 +459,24 @@ bad:
 	return (NULL);
 }
 
-void
-sixel_free(struct sixel_image *si)
+struct sixel_image *
+sixel_parse(const char *buf, size_t len, u_int p2, u_int xpixel, u_int ypixel)
 {
-	u_int	y;
+	struct sixel_image	*si;
 
-	for (y = 0; y < si->y; y++)
-		free(si->lines[y].data);
-	free(si->lines);
+	if (len == 0 || len == 1 || *buf != 'q') {
+		log_debug("%s: empty image", __func__);
+		return (NULL);
+	}
 
+	si = sixel_parse_start(p2, xpixel, ypixel);
+	return (sixel_parse_end(si, buf + 1, len - 1));
+}
+
+void
+sixel_free(struct sixel_image *si)
+{
+	free(si->data);
 	free(si->colours);
 	free(si);
 }
@@ -371,21 +484,18 @@ sixel_free(struct sixel_image *si)
 void
 sixel_log(struct sixel_image *si)
 {
-	struct sixel_line	*sl;
 	char			 s[SIXEL_WIDTH_LIMIT + 1];
-	u_int			 i, x, y, cx, cy;
+	u_int			 i, x, y, cx, cy, c;
 
 	sixel_size_in_cells(si, &cx, &cy);
 	log_debug("%s: image %ux%u (%ux%u)", __func__, si->x, si->y, cx, cy);
 	for (i = 0; i < si->ncolours; i++)
 		log_debug("%s: colour %u is %07x", __func__, i, si->colours[i]);
 	for (y = 0; y < si->y; y++) {
-		sl = &si->lines[y];
 		for (x = 0; x < si->x; x++) {
-			if (x >= sl->x)
-				s[x] = '_';
-			else if (sl->data[x] != 0)
-				s[x] = '0' + (sl->data[x] - 1) % 10;
+			c = sixel_get_pixel(si, x, y);
+			if (c != 0)
+				s[x] = '0' + (c - 1) % 10;
 			else
 				s[x] = '.';
 			}
@@ -394,6 +504,21 @@ sixel_log(struct sixel_image *si)
 	}
 }
 
+/*
+ * Get the memory used by an image. Once it has been parsed, the block holds no
+ * more than the image size, and less if not all of it was set.
+ */
+size_t
+sixel_size_in_bytes(struct sixel_image *si)
+{
+	size_t	size;
+
+	size = sizeof *si;
+	size += si->ncolours * sizeof *si->colours;
+	size += (size_t)si->rows * si->stride * sizeof *si->data;
+	return (size);
+}
+
 void
 sixel_size_in_cells(struct sixel_image *si, u_int *x, u_int *y)
 {
@@ -460,6 +585,7 @@ sixel_scale(struct sixel_image *si, u_int xpixel, u_int ypixel, u_int ox,
 	new->ra_y = new->ra_y * ypixel / si->ypixel;
 
 	new->used_colours = si->used_colours;
+	sixel_grow(new, tsx, tsy);
 	for (y = 0; y < tsy; y++) {
 		py = poy + ((double)y * psy / tsy);
 		for (x = 0; x < tsx; x++) {
@@ -516,18 +642,13 @@ sixel_print_compress_colors(struct sixel_image *si, struct sixel_chunk *chunks,
 {
 	u_int			 i, x, c, dx, colors[6];
 	struct sixel_chunk	*chunk = NULL;
-	struct sixel_line	*sl;
 
 	for (x = 0; x < si->x; x++) {
 		for (i = 0; i < 6; i++) {
-			colors[i] = 0;
-			if (y + i < si->y) {
-				sl = &si->lines[y + i];
-				if (x < sl->x && sl->data[x] != 0) {
-					colors[i] = sl->data[x];
-					c = sl->data[x] - 1;
-					chunks[c].next_pattern |= 1 << i;
-				}
+			colors[i] = sixel_get_pixel(si, x, y + i);
+			if (colors[i] != 0) {
+				c = colors[i] - 1;
+				chunks[c].next_pattern |= 1 << i;
 			}
 		}
 
@@ -24,8 +24,8 @@
 #include "tmux.h"
 
 static struct images	all_images = TAILQ_HEAD_INITIALIZER(all_images);
-static u_int		all_images_count;
-#define MAX_IMAGE_COUNT 20
+static size_t		all_images_size;
+#define MAX_IMAGE_OUTPUTS 4
 
 static void printflike(3, 4)
 image_log(struct image *im, const char* from, const char* fmt, ...)
@@ -50,13 +50,42 @@ image_log(struct image *im, const char* from, const char* fmt, ...)
 	    im->px, im->py, s);
 }
 
+static void
+image_free_outputs(struct image *im)
+{
+	struct image_output	*io, *io1;
+
+	TAILQ_FOREACH_SAFE(io, &im->outputs, entry, io1) {
+		TAILQ_REMOVE(&im->outputs, io, entry);
+		free(io->data);
+		free(io);
+	}
+	im->noutputs = 0;
+}
+
+static void
+image_update_size(struct image *im)
+{
+	struct image_output	*io;
+
+	all_images_size -= im->size;
+
+	im->size = sizeof *im + sixel_size_in_bytes(im->data);
+	im->size += strlen(im->fallback) + 1;
+	TAILQ_FOREACH(io, &im->outputs, entry)
+		im->size += sizeof *io + io->size;
+
+	all_images_size += im->size;
+}
+
 static void
 image_free(struct image *im)
 {
 	image_log(im, __func__, NULL);
+	image_free_outputs(im);
 
 	TAILQ_REMOVE(&all_images, im, all_entry);
-	all_images_count--;
+	all_images_size -= im->size;
 
 	TAILQ_REMOVE(im->list, im, entry);
 	sixel_free(im->data);
@@ -64,6 +93,35 @@ image_free(struct image *im)
 	free(im);
 }
 
+/*
+ * Free the least recently used images until under the limit, except for the
+ * given image. If images may not be freed now (because the caller may be
+ * walking a list of them), only free their cached outputs.
+ */
+static void
+image_evict(struct image *keep, int outputs_only)
+{
+	struct image	*im, *im1;
+	size_t		 limit;
+
+	limit = options_get_number_id(global_options,
+	    OPTION_IMAGE_MEMORY_LIMIT);
+	TAILQ_FOREACH_SAFE(im, &all_images, all_entry, im1) {
+		if (all_images_size <= limit)
+			break;
+		if (im == keep)
+			continue;
+		if (outputs_only) {
+			if (im->noutputs != 0) {
+				image_free_outputs(im);
+				image_update_size(im);
+			}
+		} else
+			image_free(im);
+	}
+	log_debug("%s: %zu bytes used by images", __func__, all_images_size);
+}
+
 int
 image_free_all(struct screen *s)
 {
@@ -77,6 +135,36 @@ image_free_all(struct screen *s)
 	return (redraw);
 }
 
+/* Free images saved while the alternate screen is in use. */
+int
+image_free_saved(struct screen *s)
+{
+	struct image	*im, *im1;
+	int		 freed = !TAILQ_EMPTY(&s->saved_images);
+
+	if (freed)
+		log_debug ("%s", __func__);
+	TAILQ_FOREACH_SAFE(im, &s->saved_images, entry, im1)
+		image_free(im);
+	return (freed);
+}
+
+/* Get the memory used by images on a screen, or all images if NULL. */
+size_t
+image_memory(struct screen *s)
+{
+	struct image	*im;
+	size_t		 size = 0;
+
+	if (s == NULL)
+		return (all_images_size);
+	TAILQ_FOREACH(im, &s->images, entry)
+		size += im->size;
+	TAILQ_FOREACH(im, &s->saved_images, entry)
+		size += im->size;
+	return (size);
+}
+
 /* Create text placeholder for an image. */
 static void
 image_fallback(char **ret, u_int sx, u_int sy)
@@ -127,6 +215,7 @@ image_store(struct screen *s, struct sixel_image *si)
 	im = xcalloc(1, sizeof *im);
 	im->s = s;
 	im->data = si;
+	TAILQ_INIT(&im->outputs);
 
 	im->px = s->cx;
 	im->py = s->cy;
@@ -139,12 +228,22 @@ image_store(struct screen *s, struct sixel_image *si)
 	TAILQ_INSERT_TAIL(im->list, im, entry);
 
 	TAILQ_INSERT_TAIL(&all_images, im, all_entry);
-	if (++all_images_count == MAX_IMAGE_COUNT)
-		image_free(TAILQ_FIRST(&all_images));
+	image_update_size(im);
+	image_evict(im, 0);
 
 	return (im);
 }
 
+/* Mark an image as drawn so it is the last to be removed. */
+void
+image_used(struct image *im)
+{
+	if (im != TAILQ_LAST(&all_images, images)) {
+		TAILQ_REMOVE(&all_images, im, all_entry);
+		TAILQ_INSERT_TAIL(&all_images, im, all_entry);
+	}
+}
+
 int
 image_check_line(struct screen *s, u_int py, u_int ny)
 {
@@ -210,13 +309,80 @@ image_scroll_up(struct screen *s, u_int lines)
 		new = sixel_scale(im->data, 0, 0, 0, im->sy - sy, sx, sy, 1);
 		sixel_free(im->data);
 		im->data = new;
+		image_free_outputs(im);
 
 		im->py = 0;
 		sixel_size_in_cells(im->data, &im->sx, &im->sy);
 
 		free(im->fallback);
 		image_fallback(&im->fallback, im->sx, im->sy);
+		image_update_size(im);
 		redraw = 1;
 	}
 	return (redraw);
 }
+
+/*
+ * Return the image scaled to a pixel size and cropped, encoded ready to write
+ * to a terminal. The result is cached for each size and crop rectangle so
+ * redrawing the image again is cheap.
+ */
+const char *
+image_print(struct image *im, u_int xpixel, u_int ypixel, u_int ox, u_int oy,
+    u_int sx, u_int sy, size_t *size)
+{
+	struct image_output	*io;
+	struct sixel_image	*new;
+	char			*data;
+
+	TAILQ_FOREACH(io, &im->outputs, entry) {
+		if (io->xpixel == xpixel &&
+		    io->ypixel == ypixel &&
+		    io->ox == ox &&
+		    io->oy == oy &&
+		    io->sx == sx &&
+		    io->sy == sy)
+			break;
+	}
+	if (io != NULL) {
+		if (io != TAILQ_FIRST(&im->outputs)) {
+			TAILQ_REMOVE(&im->outputs, io, entry);
+			TAILQ_INSERT_HEAD(&im->outputs, io, entry);
+		}
+		*size = io->size;
+		return (io->data);
+	}
+
+	new = sixel_scale(im->data, xpixel, ypixel, ox, oy, sx, sy, 0);
+	if (new == NULL)
+		return (NULL);
+	data = sixel_print(new, im->data, size);
+	sixel_free(new);
+	if (data == NULL)
+		return (NULL);
+	image_log(im, __func__, "%ux%u pixels, %u,%u %ux%u, %zu bytes", xpixel,
+	    ypixel, ox, oy, sx, sy, *size);
+
+	if (im->noutputs == MAX_IMAGE_OUTPUTS) {
+		io = TAILQ_LAST(&im->outputs, image_outputs);
+		TAILQ_REMOVE(&im->outputs, io, entry);
+		free(io->data);
+		free(io);
+		im->noutputs--;
+	}
+	io = xcalloc(1, sizeof *io);
+	io->xpixel = xpixel;
+	io->ypixel = ypixel;
+	io->ox = ox;
+	io->oy = oy;
+	io->sx = sx;
+	io->sy = sy;
+	io->data = data;
+	io->size = *size;
+	TAILQ_INSERT_HEAD(&im->outputs, io, entry);
+	im->noutputs++;
+	image_update_size(im);
+	image_evict(im, 1);
+
+	return (io->data);
+}
@@ -121,6 +121,12 @@ struct input_ctx {
 	size_t				input_space;
 	enum input_end_type		input_end;
 
+#ifdef ENABLE_SIXEL
+#define INPUT_SIXEL_CHUNK 4096
+	struct sixel_image	       *sixel;
+	size_t				sixel_used;
+#endif
+
 	struct input_param		param_list[24];
 	u_int				param_list_len;
 
@@ -206,6 +212,9 @@ static void	input_csi_dispatch_sgr_256(struct input_ctx *, int, u_int *);
 static void	input_csi_dispatch_sgr_rgb(struct input_ctx *, int, u_int *);
 static void	input_csi_dispatch_sgr(struct input_ctx *);
 static int	input_dcs_dispatch(struct input_ctx *);
+#ifdef ENABLE_SIXEL
+static void	input_sixel_data(struct input_ctx *);
+#endif
 static int	input_top_bit_set(struct input_ctx *);
 static int	input_end_bel(struct input_ctx *);
 
@@ -916,6 +925,10 @@ input_free(struct input_ctx *ictx)
 		input_free_request(ir);
 	event_del(&ictx->request_timer);
 
+#ifdef ENABLE_SIXEL
+	if (ictx->sixel != NULL)
+		sixel_free(ictx->sixel);
+#endif
 	free(ictx->input_buf);
 	evbuffer_free(ictx->since_ground);
 	event_del(&ictx->ground_timer);
@@ -1046,6 +1059,7 @@ input_parse_buffer(struct window_pane *wp, const u_char *buf, size_t len)
 {
 	struct input_ctx	*ictx = wp->ictx;
 	struct screen_write_ctx	*sctx = &ictx->ctx;
+	uint64_t		 t;
 
 	if (len == 0)
 		return;
@@ -1066,8 +1080,13 @@ input_parse_buffer(struct window_pane *wp, const u_char *buf, size_t len)
 	log_debug("%s: %%%u %s, %zu bytes: %.*s", __func__, wp->id,
 	    ictx->state->name, len, (int)len, buf);
 
+	t = stats_time();
 	input_parse(ictx, buf, len);
 	screen_write_stop(sctx);
+	stats_add_time(&global_stats.input_time, t);
+
+	wp->input_bytes += len;
+	global_stats.input += len;
 }
 
 /* Parse given input for screen. */
@@ -1205,6 +1224,13 @@ input_clear(struct input_ctx *ictx)
 
 	ictx->input_end = INPUT_END_ST;
 
+#ifdef ENABLE_SIXEL
+	if (ictx->sixel != NULL) {
+		sixel_free(ictx->sixel);
+		ictx->sixel = NULL;
+	}
+#endif
+
 	ictx->flags &= ~INPUT_DISCARD;
 }
 
@@ -1293,9 +1319,71 @@ input_input(struct input_ctx *ictx)
 	ictx->input_buf[ictx->input_len++] = ictx->ch;
 	ictx->input_buf[ictx->input_len] = '\0';
 
+#ifdef ENABLE_SIXEL
+	if (ictx->input_len >= INPUT_SIXEL_CHUNK)
+		input_sixel_data(ictx);
+#endif
 	return (0);
 }
 
+#ifdef ENABLE_SIXEL
+/*
+ * Pass the buffered part of a sixel image to the decoder, so a large image is
+ * decoded as it arrives rather than collected and parsed all at once. What has
+ * been decoded still counts against the input buffer size.
+ */
+static void
+input_sixel_data(struct input_ctx *ictx)
+{
+	struct window	*w;
+	u_char		*buf = ictx->input_buf;
+	size_t		 len = ictx->input_len, off = 0, used;
+	int		 p2;
+
+	if (ictx->wp == NULL || ictx->interm_len != 0)
+		return;
+	if (ictx->flags & INPUT_DISCARD)
+		return;
+	if (ictx->state != &input_state_dcs_handler &&
+	    ictx->state != &input_state_dcs_escape)
+		return;
+
+	if (ictx->sixel == NULL) {
+		if (buf[0] != 'q' || input_split(ictx) != 0)
+			return;
+		p2 = input_get(ictx, 1, 0, 0);
+		if (p2 == -1)
+			p2 = 0;
+		w = ictx->wp->window;
+		ictx->sixel = sixel_parse_start(p2, w->xpixel, w->ypixel);
+		ictx->sixel_used = 0;
+		off = 1;
+	}
+
+	if (sixel_parse_data(ictx->sixel, buf + off, len - off, &used) != 0) {
+		log_debug("%s: invalid image", __func__);
+		goto discard;
+	}
+	used += off;
+	ictx->sixel_used += used;
+	if (ictx->sixel_used + (len - used) > input_buffer_size) {
+		log_debug("%s: image too big", __func__);
+		goto discard;
+	}
+
+	memmove(buf, buf + used, len - used);
+	ictx->input_len = len - used;
+	buf[ictx->input_len] = '\0';
+	return;
+
+discard:
+	sixel_free(ictx->sixel);
+	ictx->sixel = NULL;
+	ictx->flags |= INPUT_DISCARD;
+	ictx->input_len = 0;
+}
+#endif
+
 /* Execute C0 control sequence. */
 static int
 input_c0_dispatch(struct input_ctx *ictx)
@@ -1528,7 +1616,8 @@ input_csi_dispatch(struct input_ctx *ictx)
 		 * Set the extended key reporting mode as per the client
 		 * request, unless "extended-keys" is set to "off".
 		 */
-		ek = options_get_number(global_options, "extended-keys");
+		ek = options_get_number_id(global_options,
+		    OPTION_EXTENDED_KEYS);
 		if (ek == 0)
 			break;
 		screen_write_mode_clear(sctx, EXTENDED_KEY_MODES);
@@ -1548,7 +1637,8 @@ input_csi_dispatch(struct input_ctx *ictx)
 		 */
 		screen_write_mode_clear(sctx,
 		    MODE_KEYS_EXTENDED|MODE_KEYS_EXTENDED_2);
-		if (options_get_number(global_options, "extended-keys") == 2)
+		if (options_get_number_id(global_options,
+		    OPTION_EXTENDED_KEYS) == 2)
 			screen_write_mode_set(sctx, MODE_KEYS_EXTENDED);
 		break;
 	case INPUT_CSI_WINOPS:
@@ -1666,7 +1756,8 @@ input_csi_dispatch(struct input_ctx *ictx)
 					oo = ictx->wp->options;
 				else
 					oo = global_w_options;
-				p = options_get_number(oo, "cursor-style");
+				p = options_get_number_id(oo,
+				    OPTION_CURSOR_STYLE);
 
 				/* blink for 1,3,5; steady for 0,2,4,6 */
 				n = (p == 1 || p == 3 || p == 5) ? 1 : 2;
@@ -2589,7 +2680,7 @@ input_handle_decrqss(struct input_ctx *ictx)
 			oo = wp->options;
 		else
 			oo = global_w_options;
-		opt_ps = options_get_number(oo, "cursor-style");
+		opt_ps = options_get_number_id(oo, OPTION_CURSOR_STYLE);
 
 		/* Sanity clamp: valid Ps are 0..6 per DECSCUSR. */
 		if (opt_ps < 0 || opt_ps > 6)
@@ -2638,6 +2729,13 @@ input_dcs_dispatch(struct input_ctx *ictx)
 	}
 
 #ifdef ENABLE_SIXEL
+	if (ictx->sixel != NULL) {
+		si = sixel_parse_end(ictx->sixel, buf, len);
+		ictx->sixel = NULL;
+		if (si != NULL)
+			screen_write_sixelimage(sctx, si, ictx->cell.cell.bg);
+		return (0);
+	}
 	if (wp != NULL && buf[0] == 'q' && ictx->interm_len == 0) {
 		w = wp->window;
 		if (input_split(ictx) != 0)
@@ -2664,7 +2762,7 @@ input_dcs_dispatch(struct input_ctx *ictx)
 		 */
 	}
 
-	allow_passthrough = options_get_number(oo, "allow-passthrough");
+	allow_passthrough = options_get_number_id(oo, OPTION_ALLOW_PASSTHROUGH);
 	if (!allow_passthrough)
 		return (0);
 	log_debug("%s: \"%s\"", __func__, buf);
@@ -2717,7 +2815,8 @@ input_exit_osc(struct input_ctx *ictx)
 	case 0:
 	case 2:
 		if (wp != NULL &&
-		    options_get_number(wp->options, "allow-set-title") &&
+		    options_get_number_id(wp->options,
+		    OPTION_ALLOW_SET_TITLE) &&
 		    screen_set_title(sctx->s, p, 1)) {
 			input_fire_pane_title_changed(wp, p);
 			server_redraw_window_borders(wp->window);
@@ -2795,7 +2894,7 @@ input_exit_apc(struct input_ctx *ictx)
 	log_debug("%s: \"%s\"", __func__, ictx->input_buf);
 
 	if (wp != NULL &&
-	    options_get_number(wp->options, "allow-set-title") &&
+	    options_get_number_id(wp->options, OPTION_ALLOW_SET_TITLE) &&
 	    screen_set_title(sctx->s, ictx->input_buf, 1)) {
 		input_fire_pane_title_changed(wp, ictx->input_buf);
 		server_redraw_window_borders(wp->window);
@@ -2826,7 +2925,7 @@ input_exit_rename(struct input_ctx *ictx)
 		return;
 	if (ictx->flags & INPUT_DISCARD)
 		return;
-	if (!options_get_number(ictx->wp->options, "allow-rename"))
+	if (!options_get_number_id(ictx->wp->options, OPTION_ALLOW_RENAME))
 		return;
 	log_debug("%s: \"%s\"", __func__, ictx->input_buf);
 
@@ -2838,7 +2937,7 @@ input_exit_rename(struct input_ctx *ictx)
 		o = options_get_only(w->options, "automatic-rename");
 		if (o != NULL)
 			options_remove_or_default(o, NULL, NULL);
-		if (!options_get_number(w->options, "automatic-rename"))
+		if (!options_get_number_id(w->options, OPTION_AUTOMATIC_RENAME))
 			window_set_name(w, "", 1);
 	} else {
 		options_set_number(w->options, "automatic-rename", 0);
@@ -3286,7 +3385,7 @@ input_osc_52_reply(struct input_ctx *ictx, char clip)
 	const char		*buf;
 	size_t			 len;
 
-	state = options_get_number(global_options, "get-clipboard");
+	state = options_get_number_id(global_options, OPTION_GET_CLIPBOARD);
 	if (state == 0)
 		return;
 	if (state == 1) {
@@ -3316,7 +3415,7 @@ input_osc_52_parse(struct input_ctx *ictx, const char *p, u_char **out,
 	const char	*allow = "cpqs01234567";
 	u_int		 i, j = 0;
 
-	if (options_get_number(global_options, "set-clipboard") != 2)
+	if (options_get_number_id(global_options, OPTION_SET_CLIPBOARD) != 2)
 		return (0);
 
 	if ((end = strchr(p, ';')) == NULL)
@@ -3588,7 +3687,7 @@ input_request_clipboard_reply(struct input_request *ir, void *data)
 	int					 state;
 	char					*copy;
 
-	state = options_get_number(global_options, "get-clipboard");
+	state = options_get_number_id(global_options, OPTION_GET_CLIPBOARD);
 	if (state == 0 || state == 1)
 		return;
 	if (state == 3) {
@@ -309,9 +309,13 @@ static void
 job_read_callback(__unused struct bufferevent *bufev, void *data)
 {
 	struct job	*job = data;
+	uint64_t	 t;
 
-	if (job->updatecb != NULL)
+	if (job->updatecb != NULL) {
+		t = stats_time();
 		job->updatecb(job);
+		stats_stall(t, __func__, job->cmd, NULL, -1);
+	}
 }
 
 /*
@@ -340,12 +344,16 @@ job_error_callback(__unused struct bufferevent *bufev, __unused short events,
     void *data)
 {
 	struct job	*job = data;
+	uint64_t	 t;
 
 	log_debug("job error %p: %s, pid %ld", job, job->cmd, (long) job->pid);
 
 	if (job->state == JOB_DEAD) {
-		if (job->completecb != NULL)
+		if (job->completecb != NULL) {
+			t = stats_time();
 			job->completecb(job);
+			stats_stall(t, __func__, job->cmd, NULL, -1);
+		}
 		job_free(job);
 	} else {
 		bufferevent_disable(job->event, EV_READ);
@@ -358,6 +366,7 @@ void
 job_check_died(pid_t pid, int status)
 {
 	struct job	*job;
+	uint64_t	 t;
 
 	LIST_FOREACH(job, &all_jobs, entry) {
 		if (pid == job->pid)
@@ -376,8 +385,11 @@ job_check_died(pid_t pid, int status)
 	job->status = status;
 
 	if (job->state == JOB_CLOSED) {
-		if (job->completecb != NULL)
+		if (job->completecb != NULL) {
+			t = stats_time();
 			job->completecb(job);
+			stats_stall(t, __func__, job->cmd, NULL, -1);
+		}
 		job_free(job);
 	} else {
 		job->pid = -1;
@@ -440,6 +440,7 @@ layout_fix_panes(struct window *w, struct window_pane *skip)
 
 	status = window_get_pane_status(w);
 
+	screen_reflow_start();
 	TAILQ_FOREACH(wp, &w->panes, entry) {
 		if ((lc = wp->layout_cell) == NULL || wp == skip)
 			continue;
@@ -494,6 +495,7 @@ layout_fix_panes(struct window *w, struct window_pane *skip)
 		    wp->sy != old_sy)
 			changed = 1;
 	}
+	screen_reflow_end();
 	if (changed)
 		redraw_invalidate_scene(w);
 }
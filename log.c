@@ -28,6 +28,23 @@
 
 static FILE	*log_file;
 static int	 log_level;
+static char	*log_name;
+
+/*
+ * Log records kept in memory. Each message is formatted into a fixed size
+ * record; escaping and writing out is done only when the buffer is shown or
+ * written to a file. A slot is claimed with an atomic increment so messages
+ * from reflow threads do not need a lock.
+ */
+#define LOG_RECORD_SIZE 240
+struct log_record {
+	uint64_t	 seq;
+	struct timeval	 tv;
+	char		 text[LOG_RECORD_SIZE];
+};
+static struct log_record	*log_records;
+static u_int			 log_records_size;
+static uint64_t			 log_records_next;
 
 /* Log callback for libevent. */
 static void
@@ -47,27 +64,130 @@ log_add_level(void)
 int
 log_get_level(void)
 {
+	if (log_level == 0 && log_records != NULL)
+		return (1);
 	return (log_level);
 }
 
+/* Open the log file. */
+static void
+log_open_file(void)
+{
+	char	*path;
+
+	xasprintf(&path, "tmux-%s-%ld.log", log_name, (long)getpid());
+	log_file = fopen(path, "a");
+	free(path);
+	if (log_file == NULL)
+		return;
+
+	setvbuf(log_file, NULL, _IOLBF, 0);
+	event_set_log_callback(log_event_cb);
+}
+
 /* Open logging to file. */
 void
 log_open(const char *name)
 {
-	char	*path;
+	free(log_name);
+	log_name = xstrdup(name);
 
 	if (log_level == 0)
 		return;
 	log_close();
+	log_open_file();
+}
 
-	xasprintf(&path, "tmux-%s-%ld.log", name, (long)getpid());
-	log_file = fopen(path, "a");
-	free(path);
-	if (log_file == NULL)
+/* Set the number of records kept in memory, zero to stop. */
+void
+log_set_buffer(u_int size)
+{
+	if (size == log_records_size)
 		return;
 
-	setvbuf(log_file, NULL, _IOLBF, 0);
-	event_set_log_callback(log_event_cb);
+	free(log_records);
+	if (size == 0)
+		log_records = NULL;
+	else
+		log_records = xcalloc(size, sizeof *log_records);
+	log_records_size = size;
+	log_records_next = 0;
+}
+
+/* Format a record from memory, or return NULL if it has been replaced. */
+static char *
+log_get_record(uint64_t n)
+{
+	struct log_record	*lr = &log_records[n % log_records_size];
+	char			*out, *s;
+
+	if (__atomic_load_n(&lr->seq, __ATOMIC_ACQUIRE) != n + 1)
+		return (NULL);
+	if (stravis(&out, lr->text, VIS_OCTAL|VIS_CSTYLE|VIS_TAB|VIS_NL) == -1)
+		return (NULL);
+	xasprintf(&s, "%lld.%06d %s", (long long)lr->tv.tv_sec,
+	    (int)lr->tv.tv_usec, out);
+	free(out);
+	return (s);
+}
+
+/* Get the first record still in memory. */
+static uint64_t
+log_first_record(void)
+{
+	if (log_records_next > log_records_size)
+		return (log_records_next - log_records_size);
+	return (0);
+}
+
+/* Write records from memory to the log file. */
+static void
+log_write_buffer(void)
+{
+	uint64_t	 n, last;
+	char		*s;
+
+	if (log_records == NULL || log_file == NULL)
+		return;
+	last = log_records_next;
+	for (n = log_first_record(); n < last; n++) {
+		if ((s = log_get_record(n)) == NULL)
+			continue;
+		fprintf(log_file, "%s\n", s);
+		free(s);
+	}
+	fflush(log_file);
+}
+
+/*
+ * Print records from memory. They are all formatted first, because printing
+ * logs more messages which would replace those not yet printed.
+ */
+void
+log_print_buffer(struct cmdq_item *item, int blank)
+{
+	uint64_t	 n, last;
+	char		**list, *s;
+	u_int		 size = 0, i;
+
+	if (log_records == NULL)
+		return;
+	last = log_records_next;
+	list = xcalloc(log_records_size, sizeof *list);
+	for (n = log_first_record(); n < last; n++) {
+		if ((s = log_get_record(n)) != NULL)
+			list[size++] = s;
+	}
+
+	for (i = 0; i < size; i++) {
+		if (blank) {
+			cmdq_print(item, "%s", "");
+			blank = 0;
+		}
+		cmdq_print(item, "%s", list[i]);
+		free(list[i]);
+	}
+	free(list);
 }
 
 /* Toggle logging. */
@@ -77,6 +197,7 @@ log_toggle(const char *name)
 	if (log_level == 0) {
 		log_level = 1;
 		log_open(name);
+		log_write_buffer();
 		log_debug("log opened");
 	} else {
 		log_debug("log closed");
@@ -96,13 +217,38 @@ log_close(void)
 	event_set_log_callback(NULL);
 }
 
+/* Add a log message to the records in memory. */
+static void printflike(1, 0)
+log_vwrite_buffer(const char *msg, va_list ap, const char *prefix)
+{
+	struct log_record	*lr;
+	uint64_t		 n;
+	size_t			 len;
+
+	n = __atomic_fetch_add(&log_records_next, 1, __ATOMIC_RELAXED);
+	lr = &log_records[n % log_records_size];
+
+	gettimeofday(&lr->tv, NULL);
+	len = strlcpy(lr->text, prefix, sizeof lr->text);
+	if (len < sizeof lr->text)
+		vsnprintf(lr->text + len, sizeof lr->text - len, msg, ap);
+
+	__atomic_store_n(&lr->seq, n + 1, __ATOMIC_RELEASE);
+}
+
 /* Write a log message. */
 static void printflike(1, 0)
 log_vwrite(const char *msg, va_list ap, const char *prefix)
 {
 	char		*s, *out;
 	struct timeval	 tv;
+	va_list		 ap2;
 
+	if (log_records != NULL) {
+		va_copy(ap2, ap);
+		log_vwrite_buffer(msg, ap2, prefix);
+		va_end(ap2);
+	}
 	if (log_file == NULL)
 		return;
 
@@ -127,7 +273,7 @@ log_debug(const char *msg, ...)
 {
 	va_list	ap;
 
-	if (log_file == NULL)
+	if (log_file == NULL && log_records == NULL)
 		return;
 
 	va_start(ap, msg);
@@ -135,6 +281,16 @@ log_debug(const char *msg, ...)
 	va_end(ap);
 }
 
+/* Write records from memory to a new log file before dying. */
+static void
+log_fatal_buffer(void)
+{
+	if (log_records == NULL || log_file != NULL || log_name == NULL)
+		return;
+	log_open_file();
+	log_write_buffer();
+}
+
 /* Log a critical error with error string and die. */
 __dead void
 fatal(const char *msg, ...)
@@ -148,6 +304,7 @@ fatal(const char *msg, ...)
 	va_start(ap, msg);
 	log_vwrite(msg, ap, tmp);
 	va_end(ap);
+	log_fatal_buffer();
 
 	exit(1);
 }
@@ -161,6 +318,7 @@ fatalx(const char *msg, ...)
 	va_start(ap, msg);
 	log_vwrite(msg, ap, "fatal: ");
 	va_end(ap);
+	log_fatal_buffer();
 
 	exit(1);
 }
@@ -281,14 +281,21 @@ const struct options_name_map options_other_names[] = {
 /* Top-level options. */
 const struct options_table_entry options_table[] = {
 	/* Server options. */
-	{ .name = "backspace",
+	[OPTION_ALLOCATION_STATS] = { .name = "allocation-stats",
+	  .type = OPTIONS_TABLE_FLAG,
+	  .scope = OPTIONS_TABLE_SERVER,
+	  .default_num = 0,
+	  .text = "Whether allocations are counted for each source file."
+	},
+
+	[OPTION_BACKSPACE] = { .name = "backspace",
 	  .type = OPTIONS_TABLE_KEY,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .default_num = '\177',
 	  .text = "The key to send for backspace."
 	},
 
-	{ .name = "buffer-limit",
+	[OPTION_BUFFER_LIMIT] = { .name = "buffer-limit",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .minimum = 1,
@@ -298,7 +305,7 @@ const struct options_table_entry options_table[] = {
 		  "When this is reached, the oldest buffer is deleted."
 	},
 
-	{ .name = "command-alias",
+	[OPTION_COMMAND_ALIAS] = { .name = "command-alias",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_ARRAY,
@@ -313,7 +320,7 @@ const struct options_table_entry options_table[] = {
 		  "Each entry is an alias and a command separated by '='."
 	},
 
-	{ .name = "codepoint-widths",
+	[OPTION_CODEPOINT_WIDTHS] = { .name = "codepoint-widths",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_ARRAY,
@@ -322,7 +329,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Array of override widths for Unicode codepoints."
 	},
 
-	{ .name = "copy-command",
+	[OPTION_COPY_COMMAND] = { .name = "copy-command",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .default_str = "",
@@ -330,7 +337,7 @@ const struct options_table_entry options_table[] = {
 		  "If empty, no command is run."
 	},
 
-	{ .name = "cursor-colour",
+	[OPTION_CURSOR_COLOUR] = { .name = "cursor-colour",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -338,7 +345,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Colour of the cursor."
 	},
 
-	{ .name = "cursor-style",
+	[OPTION_CURSOR_STYLE] = { .name = "cursor-style",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .choices = options_table_cursor_style_list,
@@ -346,28 +353,28 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of the cursor."
 	},
 
-	{ .name = "default-client-command",
+	[OPTION_DEFAULT_CLIENT_COMMAND] = { .name = "default-client-command",
 	  .type = OPTIONS_TABLE_COMMAND,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .default_str = "new-session",
 	  .text = "Default command to run when tmux is run without a command."
 	},
 
-	{ .name = "default-terminal",
+	[OPTION_DEFAULT_TERMINAL] = { .name = "default-terminal",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .default_str = TMUX_TERM,
 	  .text = "Default for the 'TERM' environment variable."
 	},
 
-	{ .name = "editor",
+	[OPTION_EDITOR] = { .name = "editor",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .default_str = _PATH_VI,
 	  .text = "Editor run to edit files."
 	},
 
-	{ .name = "escape-time",
+	[OPTION_ESCAPE_TIME] = { .name = "escape-time",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .minimum = 0,
@@ -377,14 +384,14 @@ const struct options_table_entry options_table[] = {
 	  .text = "Time to wait before assuming a key is Escape."
 	},
 
-	{ .name = "exit-empty",
+	[OPTION_EXIT_EMPTY] = { .name = "exit-empty",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .default_num = 1,
 	  .text = "Whether the server should exit if there are no sessions."
 	},
 
-	{ .name = "exit-unattached",
+	[OPTION_EXIT_UNATTACHED] = { .name = "exit-unattached",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .default_num = 0,
@@ -392,7 +399,7 @@ const struct options_table_entry options_table[] = {
 		  "clients."
 	},
 
-	{ .name = "extended-keys",
+	[OPTION_EXTENDED_KEYS] = { .name = "extended-keys",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .choices = options_table_extended_keys_list,
@@ -401,7 +408,7 @@ const struct options_table_entry options_table[] = {
 		  "that support it."
 	},
 
-	{ .name = "extended-keys-format",
+	[OPTION_EXTENDED_KEYS_FORMAT] = { .name = "extended-keys-format",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .choices = options_table_extended_keys_format_list,
@@ -409,14 +416,14 @@ const struct options_table_entry options_table[] = {
 	  .text = "The format of emitted extended key sequences."
 	},
 
-	{ .name = "focus-events",
+	[OPTION_FOCUS_EVENTS] = { .name = "focus-events",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .default_num = 0,
 	  .text = "Whether to send focus events to applications."
 	},
 
-	{ .name = "get-clipboard",
+	[OPTION_GET_CLIPBOARD] = { .name = "get-clipboard",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .choices = options_table_get_clipboard_list,
@@ -428,7 +435,7 @@ const struct options_table_entry options_table[] = {
 		  "create a buffer, and send it to the application ('both')."
 	},
 
-	{ .name = "history-file",
+	[OPTION_HISTORY_FILE] = { .name = "history-file",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .default_str = "",
@@ -436,7 +443,17 @@ const struct options_table_entry options_table[] = {
 		  "Empty does not write a history file."
 	},
 
-	{ .name = "input-buffer-size",
+	[OPTION_IMAGE_MEMORY_LIMIT] = { .name = "image-memory-limit",
+	  .type = OPTIONS_TABLE_NUMBER,
+	  .scope = OPTIONS_TABLE_SERVER,
+	  .minimum = 0,
+	  .maximum = INT_MAX,
+	  .default_num = 67108864,
+	  .text = "Number of bytes of memory images may use before the least "
+		  "recently drawn are removed."
+	},
+
+	[OPTION_INPUT_BUFFER_SIZE] = { .name = "input-buffer-size",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .minimum = INPUT_BUF_DEFAULT_SIZE,
@@ -445,7 +462,18 @@ const struct options_table_entry options_table[] = {
 	  .text = "Number of bytes accepted in a single input before dropping."
 	},
 
-	{ .name = "menu-style",
+	[OPTION_LOG_BUFFER_LINES] = { .name = "log-buffer-lines",
+	  .type = OPTIONS_TABLE_NUMBER,
+	  .scope = OPTIONS_TABLE_SERVER,
+	  .minimum = 0,
+	  .maximum = 1000000,
+	  .default_num = 0,
+	  .unit = "lines",
+	  .text = "Number of log messages to keep in memory, or zero to keep "
+		  "none."
+	},
+
+	[OPTION_MENU_STYLE] = { .name = "menu-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .flags = OPTIONS_TABLE_IS_STYLE,
@@ -454,7 +482,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Default style of menu."
 	},
 
-	{ .name = "menu-selected-style",
+	[OPTION_MENU_SELECTED_STYLE] = { .name = "menu-selected-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .flags = OPTIONS_TABLE_IS_STYLE,
@@ -463,7 +491,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Default style of selected menu item."
 	},
 
-	{ .name = "menu-border-style",
+	[OPTION_MENU_BORDER_STYLE] = { .name = "menu-border-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "bg=themedarkgrey,fg=themelightgrey",
@@ -472,7 +500,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Default style of menu borders."
 	},
 
-	{ .name = "menu-border-lines",
+	[OPTION_MENU_BORDER_LINES] = { .name = "menu-border-lines",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .choices = options_table_popup_border_lines_list,
@@ -481,7 +509,7 @@ const struct options_table_entry options_table[] = {
 		  "these are only supported on terminals with UTF-8 support."
 	},
 
-	{ .name = "message-limit",
+	[OPTION_MESSAGE_LIMIT] = { .name = "message-limit",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .minimum = 0,
@@ -490,7 +518,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Maximum number of server messages to keep."
 	},
 
-	{ .name = "prefix-timeout",
+	[OPTION_PREFIX_TIMEOUT] = { .name = "prefix-timeout",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .minimum = 0,
@@ -501,7 +529,7 @@ const struct options_table_entry options_table[] = {
 		  "pressed. Zero means disabled."
 	},
 
-	{ .name = "prompt-history-limit",
+	[OPTION_PROMPT_HISTORY_LIMIT] = { .name = "prompt-history-limit",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .minimum = 0,
@@ -510,7 +538,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Maximum number of commands to keep in history."
 	},
 
-	{ .name = "set-clipboard",
+	[OPTION_SET_CLIPBOARD] = { .name = "set-clipboard",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .choices = options_table_set_clipboard_list,
@@ -520,7 +548,18 @@ const struct options_table_entry options_table[] = {
 		  "paste buffers with an escape sequence ('on' only)."
 	},
 
-	{ .name = "terminal-overrides",
+	[OPTION_STALL_THRESHOLD] = { .name = "stall-threshold",
+	  .type = OPTIONS_TABLE_NUMBER,
+	  .scope = OPTIONS_TABLE_SERVER,
+	  .minimum = 0,
+	  .maximum = INT_MAX,
+	  .default_num = STATS_STALL_DEFAULT,
+	  .unit = "milliseconds",
+	  .text = "Time after which a command or callback blocking the server "
+		  "is recorded as a stall, or zero to record none."
+	},
+
+	[OPTION_TERMINAL_OVERRIDES] = { .name = "terminal-overrides",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_ARRAY,
@@ -529,7 +568,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "List of terminal capabilities overrides."
 	},
 
-	{ .name = "terminal-features",
+	[OPTION_TERMINAL_FEATURES] = { .name = "terminal-features",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_ARRAY,
@@ -541,7 +580,7 @@ const struct options_table_entry options_table[] = {
 		  "automatically detected."
 	},
 
-	{ .name = "theme",
+	[OPTION_THEME] = { .name = "theme",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .choices = options_table_theme_list,
@@ -550,7 +589,7 @@ const struct options_table_entry options_table[] = {
 		  "ANSI colours, or force the light or dark theme."
 	},
 
-	{ .name = "dark-theme-black",
+	[OPTION_DARK_THEME_BLACK] = { .name = "dark-theme-black",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -558,7 +597,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Dark theme colour for black."
 	},
 
-	{ .name = "dark-theme-white",
+	[OPTION_DARK_THEME_WHITE] = { .name = "dark-theme-white",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -566,7 +605,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Dark theme colour for white."
 	},
 
-	{ .name = "dark-theme-light-grey",
+	[OPTION_DARK_THEME_LIGHT_GREY] = { .name = "dark-theme-light-grey",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -574,7 +613,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Dark theme colour for light grey."
 	},
 
-	{ .name = "dark-theme-dark-grey",
+	[OPTION_DARK_THEME_DARK_GREY] = { .name = "dark-theme-dark-grey",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -582,7 +621,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Dark theme colour for dark grey."
 	},
 
-	{ .name = "dark-theme-green",
+	[OPTION_DARK_THEME_GREEN] = { .name = "dark-theme-green",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -590,7 +629,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Dark theme colour for green."
 	},
 
-	{ .name = "dark-theme-yellow",
+	[OPTION_DARK_THEME_YELLOW] = { .name = "dark-theme-yellow",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -598,7 +637,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Dark theme colour for yellow."
 	},
 
-	{ .name = "dark-theme-red",
+	[OPTION_DARK_THEME_RED] = { .name = "dark-theme-red",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -606,7 +645,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Dark theme colour for red."
 	},
 
-	{ .name = "dark-theme-blue",
+	[OPTION_DARK_THEME_BLUE] = { .name = "dark-theme-blue",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -614,7 +653,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Dark theme colour for blue."
 	},
 
-	{ .name = "dark-theme-cyan",
+	[OPTION_DARK_THEME_CYAN] = { .name = "dark-theme-cyan",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -622,7 +661,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Dark theme colour for cyan."
 	},
 
-	{ .name = "dark-theme-magenta",
+	[OPTION_DARK_THEME_MAGENTA] = { .name = "dark-theme-magenta",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -630,7 +669,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Dark theme colour for magenta."
 	},
 
-	{ .name = "light-theme-black",
+	[OPTION_LIGHT_THEME_BLACK] = { .name = "light-theme-black",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -638,7 +677,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Light theme colour for black."
 	},
 
-	{ .name = "light-theme-white",
+	[OPTION_LIGHT_THEME_WHITE] = { .name = "light-theme-white",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -646,7 +685,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Light theme colour for white."
 	},
 
-	{ .name = "light-theme-light-grey",
+	[OPTION_LIGHT_THEME_LIGHT_GREY] = { .name = "light-theme-light-grey",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -654,7 +693,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Light theme colour for light grey."
 	},
 
-	{ .name = "light-theme-dark-grey",
+	[OPTION_LIGHT_THEME_DARK_GREY] = { .name = "light-theme-dark-grey",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -662,7 +701,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Light theme colour for dark grey."
 	},
 
-	{ .name = "light-theme-green",
+	[OPTION_LIGHT_THEME_GREEN] = { .name = "light-theme-green",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -670,7 +709,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Light theme colour for green."
 	},
 
-	{ .name = "light-theme-yellow",
+	[OPTION_LIGHT_THEME_YELLOW] = { .name = "light-theme-yellow",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -678,7 +717,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Light theme colour for yellow."
 	},
 
-	{ .name = "light-theme-red",
+	[OPTION_LIGHT_THEME_RED] = { .name = "light-theme-red",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -686,7 +725,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Light theme colour for red."
 	},
 
-	{ .name = "light-theme-blue",
+	[OPTION_LIGHT_THEME_BLUE] = { .name = "light-theme-blue",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -694,7 +733,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Light theme colour for blue."
 	},
 
-	{ .name = "light-theme-cyan",
+	[OPTION_LIGHT_THEME_CYAN] = { .name = "light-theme-cyan",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -702,7 +741,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Light theme colour for cyan."
 	},
 
-	{ .name = "light-theme-magenta",
+	[OPTION_LIGHT_THEME_MAGENTA] = { .name = "light-theme-magenta",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -710,7 +749,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Light theme colour for magenta."
 	},
 
-	{ .name = "user-keys",
+	[OPTION_USER_KEYS] = { .name = "user-keys",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .flags = OPTIONS_TABLE_IS_ARRAY,
@@ -721,7 +760,7 @@ const struct options_table_entry options_table[] = {
 		  "'User0', 'User1' and so on."
 	},
 
-	{ .name = "variation-selector-always-wide",
+	[OPTION_VARIATION_SELECTOR_ALWAYS_WIDE] = { .name = "variation-selector-always-wide",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_SERVER,
 	  .default_num = 1,
@@ -730,7 +769,7 @@ const struct options_table_entry options_table[] = {
 	},
 
 	/* Session options. */
-	{ .name = "activity-action",
+	[OPTION_ACTIVITY_ACTION] = { .name = "activity-action",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .choices = options_table_bell_action_list,
@@ -738,7 +777,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Action to take on an activity alert."
 	},
 
-	{ .name = "assume-paste-time",
+	[OPTION_ASSUME_PASTE_TIME] = { .name = "assume-paste-time",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .minimum = 0,
@@ -749,7 +788,7 @@ const struct options_table_entry options_table[] = {
 		  "than typing."
 	},
 
-	{ .name = "base-index",
+	[OPTION_BASE_INDEX] = { .name = "base-index",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .minimum = 0,
@@ -758,7 +797,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Default index of the first window in each session."
 	},
 
-	{ .name = "bell-action",
+	[OPTION_BELL_ACTION] = { .name = "bell-action",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .choices = options_table_bell_action_list,
@@ -766,7 +805,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Action to take on a bell alert."
 	},
 
-	{ .name = "default-command",
+	[OPTION_DEFAULT_COMMAND] = { .name = "default-command",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_str = "",
@@ -774,14 +813,14 @@ const struct options_table_entry options_table[] = {
 		  "started."
 	},
 
-	{ .name = "default-shell",
+	[OPTION_DEFAULT_SHELL] = { .name = "default-shell",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_str = _PATH_BSHELL,
 	  .text = "Location of default shell."
 	},
 
-	{ .name = "default-size",
+	[OPTION_DEFAULT_SIZE] = { .name = "default-size",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .pattern = "[0-9]*x[0-9]*",
@@ -789,7 +828,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Initial size of new sessions."
 	},
 
-	{ .name = "destroy-unattached",
+	[OPTION_DESTROY_UNATTACHED] = { .name = "destroy-unattached",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .choices = options_table_destroy_unattached_list,
@@ -798,7 +837,7 @@ const struct options_table_entry options_table[] = {
 		  "clients, or keep the last session whether in the group."
 	},
 
-	{ .name = "detach-on-destroy",
+	[OPTION_DETACH_ON_DESTROY] = { .name = "detach-on-destroy",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .choices = options_table_detach_on_destroy_list,
@@ -807,7 +846,7 @@ const struct options_table_entry options_table[] = {
 		  "the client to another session if any exist."
 	},
 
-	{ .name = "display-panes-active-colour",
+	[OPTION_DISPLAY_PANES_ACTIVE_COLOUR] = { .name = "display-panes-active-colour",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -815,7 +854,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Colour of the active pane for 'display-panes'."
 	},
 
-	{ .name = "display-panes-colour",
+	[OPTION_DISPLAY_PANES_COLOUR] = { .name = "display-panes-colour",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -823,7 +862,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Colour of not active panes for 'display-panes'."
 	},
 
-	{ .name = "display-panes-format",
+	[OPTION_DISPLAY_PANES_FORMAT] = { .name = "display-panes-format",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_str = "#[align=right]#{pane_width}x#{pane_height}",
@@ -831,7 +870,7 @@ const struct options_table_entry options_table[] = {
 		  "pane."
 	},
 
-	{ .name = "display-panes-time",
+	[OPTION_DISPLAY_PANES_TIME] = { .name = "display-panes-time",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .minimum = 1,
@@ -841,7 +880,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Time for which 'display-panes' should show pane numbers."
 	},
 
-	{ .name = "display-time",
+	[OPTION_DISPLAY_TIME] = { .name = "display-time",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .minimum = 0,
@@ -851,14 +890,14 @@ const struct options_table_entry options_table[] = {
 	  .text = "Time for which status line messages should appear."
 	},
 
-	{ .name = "focus-follows-mouse",
+	[OPTION_FOCUS_FOLLOWS_MOUSE] = { .name = "focus-follows-mouse",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_num = 0,
 	  .text = "Whether moving the mouse into a pane selects it."
 	},
 
-	{ .name = "history-limit",
+	[OPTION_HISTORY_LIMIT] = { .name = "history-limit",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .minimum = 0,
@@ -870,7 +909,7 @@ const struct options_table_entry options_table[] = {
 		  "If changed, the new value applies only to new panes."
 	},
 
-	{ .name = "initial-repeat-time",
+	[OPTION_INITIAL_REPEAT_TIME] = { .name = "initial-repeat-time",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .minimum = 0,
@@ -882,7 +921,7 @@ const struct options_table_entry options_table[] = {
 		  "Subsequent presses use the 'repeat-time' option."
 	},
 
-	{ .name = "key-table",
+	[OPTION_KEY_TABLE] = { .name = "key-table",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_str = "root",
@@ -890,7 +929,7 @@ const struct options_table_entry options_table[] = {
 		  "Key presses are first looked up in this table."
 	},
 
-	{ .name = "lock-after-time",
+	[OPTION_LOCK_AFTER_TIME] = { .name = "lock-after-time",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .minimum = 0,
@@ -900,14 +939,14 @@ const struct options_table_entry options_table[] = {
 	  .text = "Time after which a client is locked if not used."
 	},
 
-	{ .name = "lock-command",
+	[OPTION_LOCK_COMMAND] = { .name = "lock-command",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_str = TMUX_LOCK_CMD,
 	  .text = "Shell command to run to lock a client."
 	},
 
-	{ .name = "message-command-style",
+	[OPTION_MESSAGE_COMMAND_STYLE] = { .name = "message-command-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_str = "bg=themeblack,fg=themeyellow,"
@@ -919,7 +958,7 @@ const struct options_table_entry options_table[] = {
 		  "'status-keys' is set to 'vi'."
 	},
 
-	{ .name = "message-format",
+	[OPTION_MESSAGE_FORMAT] = { .name = "message-format",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_str = "#[#{?#{command_prompt},"
@@ -930,7 +969,7 @@ const struct options_table_entry options_table[] = {
 		  "The '#{message}' placeholder is replaced with the content."
 	},
 
-	{ .name = "message-line",
+	[OPTION_MESSAGE_LINE] = { .name = "message-line",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .choices = options_table_message_line_list,
@@ -938,7 +977,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Position (line) of messages and the command prompt."
 	},
 
-	{ .name = "message-style",
+	[OPTION_MESSAGE_STYLE] = { .name = "message-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_str = "bg=themeyellow,fg=themeblack,"
@@ -952,7 +991,7 @@ const struct options_table_entry options_table[] = {
 		  "the prompt area width."
 	},
 
-	{ .name = "mouse",
+	[OPTION_MOUSE] = { .name = "mouse",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_num = TMUX_MOUSE,
@@ -961,21 +1000,30 @@ const struct options_table_entry options_table[] = {
 		  "Applications inside panes can use the mouse even when 'off'."
 	},
 
-	{ .name = "prefix",
+	[OPTION_MOUSE_COALESCE] = { .name = "mouse-coalesce",
+	  .type = OPTIONS_TABLE_FLAG,
+	  .scope = OPTIONS_TABLE_SESSION,
+	  .default_num = 1,
+	  .text = "Whether mouse motion events received together are collapsed "
+		  "into the latest one. Panes which have asked for all motion "
+		  "events still get every event."
+	},
+
+	[OPTION_PREFIX] = { .name = "prefix",
 	  .type = OPTIONS_TABLE_KEY,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_num = 'b'|KEYC_CTRL,
 	  .text = "The prefix key."
 	},
 
-	{ .name = "prefix2",
+	[OPTION_PREFIX2] = { .name = "prefix2",
 	  .type = OPTIONS_TABLE_KEY,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_num = KEYC_NONE,
 	  .text = "A second prefix key."
 	},
 
-	{ .name = "renumber-windows",
+	[OPTION_RENUMBER_WINDOWS] = { .name = "renumber-windows",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_num = 0,
@@ -983,7 +1031,7 @@ const struct options_table_entry options_table[] = {
 		  "leaving gaps."
 	},
 
-	{ .name = "repeat-time",
+	[OPTION_REPEAT_TIME] = { .name = "repeat-time",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .minimum = 0,
@@ -994,21 +1042,21 @@ const struct options_table_entry options_table[] = {
 		  "with the '-r' flag."
 	},
 
-	{ .name = "set-titles",
+	[OPTION_SET_TITLES] = { .name = "set-titles",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_num = 0,
 	  .text = "Whether to set the terminal title, if supported."
 	},
 
-	{ .name = "set-titles-string",
+	[OPTION_SET_TITLES_STRING] = { .name = "set-titles-string",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_str = "#S:#I:#W - \"#T\" #{session_alerts}",
 	  .text = "Format of the terminal title to set."
 	},
 
-	{ .name = "silence-action",
+	[OPTION_SILENCE_ACTION] = { .name = "silence-action",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .choices = options_table_bell_action_list,
@@ -1016,7 +1064,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Action to take on a silence alert."
 	},
 
-	{ .name = "status",
+	[OPTION_STATUS] = { .name = "status",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .choices = options_table_status_list,
@@ -1024,7 +1072,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Number of lines in the status line."
 	},
 
-	{ .name = "status-bg",
+	[OPTION_STATUS_BG] = { .name = "status-bg",
 	  .type = OPTIONS_TABLE_COLOUR,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_num = 8,
@@ -1032,7 +1080,7 @@ const struct options_table_entry options_table[] = {
 		  "deprecated, use 'status-style' instead."
 	},
 
-	{ .name = "status-fg",
+	[OPTION_STATUS_FG] = { .name = "status-fg",
 	  .type = OPTIONS_TABLE_COLOUR,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_num = 8,
@@ -1040,7 +1088,7 @@ const struct options_table_entry options_table[] = {
 		  "deprecated, use 'status-style' instead."
 	},
 
-	{ .name = "status-format",
+	[OPTION_STATUS_FORMAT] = { .name = "status-format",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .flags = OPTIONS_TABLE_IS_ARRAY,
@@ -1052,7 +1100,7 @@ const struct options_table_entry options_table[] = {
 		  "as 'status-left'."
 	},
 
-	{ .name = "status-interval",
+	[OPTION_STATUS_INTERVAL] = { .name = "status-interval",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .minimum = 0,
@@ -1062,7 +1110,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Number of seconds between status line updates."
 	},
 
-	{ .name = "status-justify",
+	[OPTION_STATUS_JUSTIFY] = { .name = "status-justify",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .choices = options_table_status_justify_list,
@@ -1070,7 +1118,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Position of the window list in the status line."
 	},
 
-	{ .name = "status-keys",
+	[OPTION_STATUS_KEYS] = { .name = "status-keys",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .choices = options_table_status_keys_list,
@@ -1078,14 +1126,14 @@ const struct options_table_entry options_table[] = {
 	  .text = "Key set to use at the command prompt."
 	},
 
-	{ .name = "status-left",
+	[OPTION_STATUS_LEFT] = { .name = "status-left",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_str = "[#{session_name}] ",
 	  .text = "Contents of the left side of the status line."
 	},
 
-	{ .name = "status-left-length",
+	[OPTION_STATUS_LEFT_LENGTH] = { .name = "status-left-length",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .minimum = 0,
@@ -1094,7 +1142,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Maximum width of the left side of the status line."
 	},
 
-	{ .name = "status-left-style",
+	[OPTION_STATUS_LEFT_STYLE] = { .name = "status-left-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_str = "default",
@@ -1103,7 +1151,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of the left side of the status line."
 	},
 
-	{ .name = "status-position",
+	[OPTION_STATUS_POSITION] = { .name = "status-position",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .choices = options_table_status_position_list,
@@ -1111,7 +1159,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Position of the status line."
 	},
 
-	{ .name = "status-right",
+	[OPTION_STATUS_RIGHT] = { .name = "status-right",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_str = "#{?window_bigger,"
@@ -1121,7 +1169,7 @@ const struct options_table_entry options_table[] = {
 
 	},
 
-	{ .name = "status-right-length",
+	[OPTION_STATUS_RIGHT_LENGTH] = { .name = "status-right-length",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .minimum = 0,
@@ -1130,7 +1178,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Maximum width of the right side of the status line."
 	},
 
-	{ .name = "status-right-style",
+	[OPTION_STATUS_RIGHT_STYLE] = { .name = "status-right-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_str = "default",
@@ -1139,7 +1187,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of the right side of the status line."
 	},
 
-	{ .name = "status-style",
+	[OPTION_STATUS_STYLE] = { .name = "status-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .default_str = "bg=themegreen,fg=themeblack",
@@ -1148,7 +1196,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of the status line."
 	},
 
-	{ .name = "pane-status-current-style",
+	[OPTION_PANE_STATUS_CURRENT_STYLE] = { .name = "pane-status-current-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "underscore",
@@ -1157,7 +1205,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of the current pane in the status line."
 	},
 
-	{ .name = "pane-status-style",
+	[OPTION_PANE_STATUS_STYLE] = { .name = "pane-status-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "default",
@@ -1167,7 +1215,7 @@ const struct options_table_entry options_table[] = {
 		  "pane."
 	},
 
-	{ .name = "prompt-cursor-colour",
+	[OPTION_PROMPT_CURSOR_COLOUR] = { .name = "prompt-cursor-colour",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -1175,7 +1223,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Colour of the cursor when in the command prompt."
 	},
 
-	{ .name = "prompt-command-cursor-colour",
+	[OPTION_PROMPT_COMMAND_CURSOR_COLOUR] = { .name = "prompt-command-cursor-colour",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -1184,7 +1232,7 @@ const struct options_table_entry options_table[] = {
 		  "mode, if 'status-keys' is set to 'vi'."
 	},
 
-	{ .name = "prompt-cursor-style",
+	[OPTION_PROMPT_CURSOR_STYLE] = { .name = "prompt-cursor-style",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .choices = options_table_cursor_style_list,
@@ -1192,7 +1240,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of the cursor when in the command prompt."
 	},
 
-	{ .name = "prompt-command-cursor-style",
+	[OPTION_PROMPT_COMMAND_CURSOR_STYLE] = { .name = "prompt-command-cursor-style",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .choices = options_table_cursor_style_list,
@@ -1201,7 +1249,7 @@ const struct options_table_entry options_table[] = {
 		  "mode, if 'status-keys' is set to 'vi'."
 	},
 
-	{ .name = "session-status-current-style",
+	[OPTION_SESSION_STATUS_CURRENT_STYLE] = { .name = "session-status-current-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "underscore",
@@ -1210,7 +1258,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of the current session in the status line."
 	},
 
-	{ .name = "session-status-style",
+	[OPTION_SESSION_STATUS_STYLE] = { .name = "session-status-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "default",
@@ -1220,7 +1268,7 @@ const struct options_table_entry options_table[] = {
 		  "session."
 	},
 
-	{ .name = "update-environment",
+	[OPTION_UPDATE_ENVIRONMENT] = { .name = "update-environment",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .flags = OPTIONS_TABLE_IS_ARRAY,
@@ -1232,7 +1280,7 @@ const struct options_table_entry options_table[] = {
 		  "environment when a client is attached."
 	},
 
-	{ .name = "visual-activity",
+	[OPTION_VISUAL_ACTIVITY] = { .name = "visual-activity",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .choices = options_table_visual_bell_list,
@@ -1241,7 +1289,7 @@ const struct options_table_entry options_table[] = {
 		  "a message and a bell ('both') or nothing ('off')."
 	},
 
-	{ .name = "visual-bell",
+	[OPTION_VISUAL_BELL] = { .name = "visual-bell",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .choices = options_table_visual_bell_list,
@@ -1250,7 +1298,7 @@ const struct options_table_entry options_table[] = {
 		  "a message and a bell ('both') or nothing ('off')."
 	},
 
-	{ .name = "visual-silence",
+	[OPTION_VISUAL_SILENCE] = { .name = "visual-silence",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  .choices = options_table_visual_bell_list,
@@ -1259,7 +1307,7 @@ const struct options_table_entry options_table[] = {
 		  "a message and a bell ('both') or nothing ('off')."
 	},
 
-	{ .name = "word-separators",
+	[OPTION_WORD_SEPARATORS] = { .name = "word-separators",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_SESSION,
 	  /*
@@ -1271,7 +1319,7 @@ const struct options_table_entry options_table[] = {
 	},
 
 	/* Window options. */
-	{ .name = "aggressive-resize",
+	[OPTION_AGGRESSIVE_RESIZE] = { .name = "aggressive-resize",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_num = 0,
@@ -1281,7 +1329,7 @@ const struct options_table_entry options_table[] = {
 		  "linked to ('off')."
 	},
 
-	{ .name = "allow-passthrough",
+	[OPTION_ALLOW_PASSTHROUGH] = { .name = "allow-passthrough",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .choices = options_table_allow_passthrough_list,
@@ -1292,7 +1340,7 @@ const struct options_table_entry options_table[] = {
 		  "is invisible)."
 	},
 
-	{ .name = "allow-rename",
+	[OPTION_ALLOW_RENAME] = { .name = "allow-rename",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .default_num = 0,
@@ -1300,7 +1348,7 @@ const struct options_table_entry options_table[] = {
 		  "to rename windows."
 	},
 
-	{ .name = "allow-set-title",
+	[OPTION_ALLOW_SET_TITLE] = { .name = "allow-set-title",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .default_num = 1,
@@ -1308,7 +1356,7 @@ const struct options_table_entry options_table[] = {
 		  "to set the pane title."
 	},
 
-	{ .name = "alternate-screen",
+	[OPTION_ALTERNATE_SCREEN] = { .name = "alternate-screen",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .default_num = 1,
@@ -1316,14 +1364,14 @@ const struct options_table_entry options_table[] = {
 		  "screen."
 	},
 
-	{ .name = "automatic-rename",
+	[OPTION_AUTOMATIC_RENAME] = { .name = "automatic-rename",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_num = 1,
 	  .text = "Whether windows are automatically renamed."
 	},
 
-	{ .name = "automatic-rename-format",
+	[OPTION_AUTOMATIC_RENAME_FORMAT] = { .name = "automatic-rename-format",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "#{?pane_in_mode,[tmux],#{pane_current_command}}"
@@ -1331,7 +1379,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Format used to automatically rename windows."
 	},
 
-	{ .name = "clock-mode-colour",
+	[OPTION_CLOCK_MODE_COLOUR] = { .name = "clock-mode-colour",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .flags = OPTIONS_TABLE_IS_COLOUR,
@@ -1339,7 +1387,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Colour of the clock in clock mode."
 	},
 
-	{ .name = "clock-mode-style",
+	[OPTION_CLOCK_MODE_STYLE] = { .name = "clock-mode-style",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .choices = options_table_clock_mode_style_list,
@@ -1347,7 +1395,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Time format of the clock in clock mode."
 	},
 
-	{ .name = "copy-mode-match-style",
+	[OPTION_COPY_MODE_MATCH_STYLE] = { .name = "copy-mode-match-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "bg=themecyan,fg=themeblack",
@@ -1356,7 +1404,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of search matches in copy mode."
 	},
 
-	{ .name = "copy-mode-current-match-style",
+	[OPTION_COPY_MODE_CURRENT_MATCH_STYLE] = { .name = "copy-mode-current-match-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "bg=thememagenta,fg=themeblack",
@@ -1365,7 +1413,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of the current search match in copy mode."
 	},
 
-	{ .name = "copy-mode-mark-style",
+	[OPTION_COPY_MODE_MARK_STYLE] = { .name = "copy-mode-mark-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "bg=themeyellow,fg=themeblack",
@@ -1374,7 +1422,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of the marked line in copy mode."
 	},
 
-	{ .name = "copy-mode-position-format",
+	[OPTION_COPY_MODE_POSITION_FORMAT] = { .name = "copy-mode-position-format",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .default_str = "#[align=right]"
@@ -1386,7 +1434,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Format of the position indicator in copy mode."
 	},
 
-	{ .name = "copy-mode-position-style",
+	[OPTION_COPY_MODE_POSITION_STYLE] = { .name = "copy-mode-position-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "#{E:mode-style}",
@@ -1395,7 +1443,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of position indicator in copy mode."
 	},
 
-	{ .name = "copy-mode-selection-style",
+	[OPTION_COPY_MODE_SELECTION_STYLE] = { .name = "copy-mode-selection-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "#{E:mode-style}",
@@ -1404,7 +1452,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of selection in copy mode."
 	},
 
-	{ .name = "copy-mode-current-line-number-style",
+	[OPTION_COPY_MODE_CURRENT_LINE_NUMBER_STYLE] = { .name = "copy-mode-current-line-number-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "fg=themeyellow",
@@ -1413,7 +1461,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of current line number in copy mode."
 	},
 
-	{ .name = "copy-mode-line-number-style",
+	[OPTION_COPY_MODE_LINE_NUMBER_STYLE] = { .name = "copy-mode-line-number-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "fg=themelightgrey,dim",
@@ -1422,7 +1470,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of line numbers in copy mode."
 	},
 
-	{ .name = "copy-mode-line-numbers",
+	[OPTION_COPY_MODE_LINE_NUMBERS] = { .name = "copy-mode-line-numbers",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .choices = options_table_copy_mode_line_numbers_list,
@@ -1430,14 +1478,14 @@ const struct options_table_entry options_table[] = {
 	  .text = "Line number mode in copy mode."
 	},
 
-	{ .name = "fill-character",
+	[OPTION_FILL_CHARACTER] = { .name = "fill-character",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "",
 	  .text = "Character used to fill unused parts of window."
 	},
 
-	{ .name = "main-pane-height",
+	[OPTION_MAIN_PANE_HEIGHT] = { .name = "main-pane-height",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "24",
@@ -1445,7 +1493,7 @@ const struct options_table_entry options_table[] = {
 		  "This may be a percentage, for example '10%'."
 	},
 
-	{ .name = "main-pane-width",
+	[OPTION_MAIN_PANE_WIDTH] = { .name = "main-pane-width",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "80",
@@ -1453,7 +1501,7 @@ const struct options_table_entry options_table[] = {
 		  "This may be a percentage, for example '10%'."
 	},
 
-	{ .name = "mode-keys",
+	[OPTION_MODE_KEYS] = { .name = "mode-keys",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .choices = options_table_mode_keys_list,
@@ -1461,7 +1509,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Key set used in copy mode."
 	},
 
-	{ .name = "mode-style",
+	[OPTION_MODE_STYLE] = { .name = "mode-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .flags = OPTIONS_TABLE_IS_STYLE,
@@ -1470,21 +1518,21 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of indicators and highlighting in modes."
 	},
 
-	{ .name = "monitor-activity",
+	[OPTION_MONITOR_ACTIVITY] = { .name = "monitor-activity",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_num = 0,
 	  .text = "Whether an alert is triggered by activity."
 	},
 
-	{ .name = "monitor-bell",
+	[OPTION_MONITOR_BELL] = { .name = "monitor-bell",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_num = 1,
 	  .text = "Whether an alert is triggered by a bell."
 	},
 
-	{ .name = "monitor-silence",
+	[OPTION_MONITOR_SILENCE] = { .name = "monitor-silence",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .minimum = 0,
@@ -1495,7 +1543,7 @@ const struct options_table_entry options_table[] = {
 
 	},
 
-	{ .name = "other-pane-height",
+	[OPTION_OTHER_PANE_HEIGHT] = { .name = "other-pane-height",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "0",
@@ -1503,7 +1551,7 @@ const struct options_table_entry options_table[] = {
 		  "This may be a percentage, for example '10%'."
 	},
 
-	{ .name = "other-pane-width",
+	[OPTION_OTHER_PANE_WIDTH] = { .name = "other-pane-width",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "0",
@@ -1511,7 +1559,7 @@ const struct options_table_entry options_table[] = {
 		  "This may be a percentage, for example '10%'."
 	},
 
-	{ .name = "pane-active-border-style",
+	[OPTION_PANE_ACTIVE_BORDER_STYLE] = { .name = "pane-active-border-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .default_str = "fg=#{?pane_marked,thememagenta,"
@@ -1522,7 +1570,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of the active pane border."
 	},
 
-	{ .name = "pane-base-index",
+	[OPTION_PANE_BASE_INDEX] = { .name = "pane-base-index",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .minimum = 0,
@@ -1531,7 +1579,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Index of the first pane in each window."
 	},
 
-	{ .name = "pane-border-format",
+	[OPTION_PANE_BORDER_FORMAT] = { .name = "pane-border-format",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .default_str = "#{?pane_active,#[reverse],}#{pane_index}#[default] "
@@ -1549,7 +1597,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Format of text in the pane status lines."
 	},
 
-	{ .name = "pane-border-indicators",
+	[OPTION_PANE_BORDER_INDICATORS] = { .name = "pane-border-indicators",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .choices = options_table_pane_border_indicators_list,
@@ -1558,7 +1606,7 @@ const struct options_table_entry options_table[] = {
 		  "displaying arrow markers."
 	},
 
-	{ .name = "pane-border-lines",
+	[OPTION_PANE_BORDER_LINES] = { .name = "pane-border-lines",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .choices = options_table_pane_border_lines_list,
@@ -1567,7 +1615,7 @@ const struct options_table_entry options_table[] = {
 		  "these are only supported on terminals with UTF-8 support."
 	},
 
-	{ .name = "pane-border-status",
+	[OPTION_PANE_BORDER_STATUS] = { .name = "pane-border-status",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .choices = options_table_pane_status_list,
@@ -1575,7 +1623,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Position of the pane status lines."
 	},
 
-	{ .name = "pane-border-style",
+	[OPTION_PANE_BORDER_STYLE] = { .name = "pane-border-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .default_str = "fg=themelightgrey",
@@ -1584,7 +1632,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of the pane status lines."
 	},
 
-	{ .name = "pane-colours",
+	[OPTION_PANE_COLOURS] = { .name = "pane-colours",
 	  .type = OPTIONS_TABLE_COLOUR,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .default_str = "",
@@ -1592,7 +1640,18 @@ const struct options_table_entry options_table[] = {
 	  .text = "The default colour palette for colours zero to 255."
 	},
 
-	{ .name = "pane-scrollbars",
+	[OPTION_PANE_MEMORY_LIMIT] = { .name = "pane-memory-limit",
+	  .type = OPTIONS_TABLE_NUMBER,
+	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
+	  .minimum = 0,
+	  .maximum = LLONG_MAX,
+	  .default_num = 0,
+	  .unit = "bytes",
+	  .text = "Number of bytes of memory a pane may use before its images "
+		  "and oldest history are removed, or zero for no limit."
+	},
+
+	[OPTION_PANE_SCROLLBARS] = { .name = "pane-scrollbars",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .choices = options_table_pane_scrollbars_list,
@@ -1600,7 +1659,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Pane scrollbar state: off, on, modal, or auto-hide."
 	},
 
-	{ .name = "pane-scrollbars-timeout",
+	[OPTION_PANE_SCROLLBARS_TIMEOUT] = { .name = "pane-scrollbars-timeout",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .minimum = 0,
@@ -1610,7 +1669,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Time before modal and auto-hide pane scrollbars disappear."
 	},
 
-	{ .name = "pane-scrollbars-style",
+	[OPTION_PANE_SCROLLBARS_STYLE] = { .name = "pane-scrollbars-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .default_str = "bg=themedarkgrey,fg=themelightgrey,width=1,pad=0",
@@ -1619,7 +1678,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of the pane scrollbar."
 	},
 
-	{ .name = "pane-scrollbars-position",
+	[OPTION_PANE_SCROLLBARS_POSITION] = { .name = "pane-scrollbars-position",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .choices = options_table_pane_scrollbars_position_list,
@@ -1627,7 +1686,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Pane scrollbar position."
 	},
 
-	{ .name = "popup-style",
+	[OPTION_POPUP_STYLE] = { .name = "popup-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "bg=themedarkgrey,fg=themewhite",
@@ -1636,7 +1695,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Default style of popups."
 	},
 
-	{ .name = "popup-border-style",
+	[OPTION_POPUP_BORDER_STYLE] = { .name = "popup-border-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "bg=themedarkgrey,fg=themelightgrey",
@@ -1645,7 +1704,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Default style of popup borders."
 	},
 
-	{ .name = "popup-border-lines",
+	[OPTION_POPUP_BORDER_LINES] = { .name = "popup-border-lines",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .choices = options_table_popup_border_lines_list,
@@ -1654,7 +1713,7 @@ const struct options_table_entry options_table[] = {
 		  "these are only supported on terminals with UTF-8 support."
 	},
 
-	{ .name = "remain-on-exit",
+	[OPTION_REMAIN_ON_EXIT] = { .name = "remain-on-exit",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .choices = options_table_remain_on_exit_list,
@@ -1664,7 +1723,7 @@ const struct options_table_entry options_table[] = {
 		  "'failed') when the program inside exits."
 	},
 
-	{ .name = "remain-on-exit-format",
+	[OPTION_REMAIN_ON_EXIT_FORMAT] = { .name = "remain-on-exit-format",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .default_str = "Pane is dead ("
@@ -1677,7 +1736,7 @@ const struct options_table_entry options_table[] = {
 		  "remain-on-exit is enabled."
 	},
 
-	{ .name = "scroll-on-clear",
+	[OPTION_SCROLL_ON_CLEAR] = { .name = "scroll-on-clear",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .default_num = 1,
@@ -1685,7 +1744,7 @@ const struct options_table_entry options_table[] = {
 		  "history when clearing the whole screen."
 	},
 
-	{ .name = "switch-mode-match-style",
+	[OPTION_SWITCH_MODE_MATCH_STYLE] = { .name = "switch-mode-match-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .default_str = "bg=cyan fg=black",
@@ -1694,14 +1753,14 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of matched characters in switch mode."
 	},
 
-	{ .name = "synchronize-panes",
+	[OPTION_SYNCHRONIZE_PANES] = { .name = "synchronize-panes",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .default_num = 0,
 	  .text = "Whether typing should be sent to all panes simultaneously."
 	},
 
-	{ .name = "tiled-layout-max-columns",
+	[OPTION_TILED_LAYOUT_MAX_COLUMNS] = { .name = "tiled-layout-max-columns",
 	  .type = OPTIONS_TABLE_NUMBER,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .minimum = 0,
@@ -1711,7 +1770,7 @@ const struct options_table_entry options_table[] = {
 		  "A value of 0 means no limit."
 	},
 
-	{ .name = "tree-mode-border-style",
+	[OPTION_TREE_MODE_BORDER_STYLE] = { .name = "tree-mode-border-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "bg=themedarkgrey,fg=themelightgrey",
@@ -1720,7 +1779,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of borders in tree mode."
 	},
 
-	{ .name = "tree-mode-preview-format",
+	[OPTION_TREE_MODE_PREVIEW_FORMAT] = { .name = "tree-mode-preview-format",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .default_str = "#{?pane_format,"
@@ -1729,7 +1788,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Format of the preview indicator in tree mode."
 	},
 
-	{ .name = "tree-mode-preview-style",
+	[OPTION_TREE_MODE_PREVIEW_STYLE] = { .name = "tree-mode-preview-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "fg=#{?#{||:"
@@ -1742,7 +1801,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of preview indicator in tree mode."
 	},
 
-	{ .name = "tree-mode-selection-style",
+	[OPTION_TREE_MODE_SELECTION_STYLE] = { .name = "tree-mode-selection-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "#{E:mode-style}",
@@ -1751,7 +1810,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of the selected line in tree mode."
 	},
 
-	{ .name = "window-active-style",
+	[OPTION_WINDOW_ACTIVE_STYLE] = { .name = "window-active-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .default_str = "default",
@@ -1760,14 +1819,14 @@ const struct options_table_entry options_table[] = {
 	  .text = "Default style of the active pane."
 	},
 
-	{ .name = "window-pane-current-status-format",
+	[OPTION_WINDOW_PANE_CURRENT_STATUS_FORMAT] = { .name = "window-pane-current-status-format",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "#P:[#T]#{?pane_flags,#{pane_flags}, }",
 	  .text = "Format of the current window pane in the status line."
 	},
 
-	{ .name = "window-pane-status-format",
+	[OPTION_WINDOW_PANE_STATUS_FORMAT] = { .name = "window-pane-status-format",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "#P:[#T]#{?pane_flags,#{pane_flags}, }",
@@ -1775,7 +1834,7 @@ const struct options_table_entry options_table[] = {
 		  "current pane."
 	},
 
-	{ .name = "window-size",
+	[OPTION_WINDOW_SIZE] = { .name = "window-size",
 	  .type = OPTIONS_TABLE_CHOICE,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .choices = options_table_window_size_list,
@@ -1787,7 +1846,7 @@ const struct options_table_entry options_table[] = {
 		  "command."
 	},
 
-	{ .name = "window-style",
+	[OPTION_WINDOW_STYLE] = { .name = "window-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW|OPTIONS_TABLE_PANE,
 	  .default_str = "default",
@@ -1796,7 +1855,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Default style of panes that are not the active pane."
 	},
 
-	{ .name = "window-status-activity-style",
+	[OPTION_WINDOW_STATUS_ACTIVITY_STYLE] = { .name = "window-status-activity-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "reverse",
@@ -1805,7 +1864,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of windows in the status line with an activity alert."
 	},
 
-	{ .name = "window-status-bell-style",
+	[OPTION_WINDOW_STATUS_BELL_STYLE] = { .name = "window-status-bell-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "reverse",
@@ -1814,14 +1873,14 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of windows in the status line with a bell alert."
 	},
 
-	{ .name = "window-status-current-format",
+	[OPTION_WINDOW_STATUS_CURRENT_FORMAT] = { .name = "window-status-current-format",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "#I:#W#{?window_flags,#{window_flags}, }",
 	  .text = "Format of the current window in the status line."
 	},
 
-	{ .name = "window-status-current-style",
+	[OPTION_WINDOW_STATUS_CURRENT_STYLE] = { .name = "window-status-current-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "underscore",
@@ -1830,7 +1889,7 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of the current window in the status line."
 	},
 
-	{ .name = "window-status-format",
+	[OPTION_WINDOW_STATUS_FORMAT] = { .name = "window-status-format",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "#I:#W#{?window_flags,#{window_flags}, }",
@@ -1838,7 +1897,7 @@ const struct options_table_entry options_table[] = {
 		  "window."
 	},
 
-	{ .name = "window-status-last-style",
+	[OPTION_WINDOW_STATUS_LAST_STYLE] = { .name = "window-status-last-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "default",
@@ -1847,14 +1906,14 @@ const struct options_table_entry options_table[] = {
 	  .text = "Style of the last window in the status line."
 	},
 
-	{ .name = "window-status-separator",
+	[OPTION_WINDOW_STATUS_SEPARATOR] = { .name = "window-status-separator",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = " ",
 	  .text = "Separator between windows in the status line."
 	},
 
-	{ .name = "window-status-style",
+	[OPTION_WINDOW_STATUS_STYLE] = { .name = "window-status-style",
 	  .type = OPTIONS_TABLE_STRING,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_str = "default",
@@ -1864,7 +1923,7 @@ const struct options_table_entry options_table[] = {
 		  "last windows."
 	},
 
-	{ .name = "wrap-search",
+	[OPTION_WRAP_SEARCH] = { .name = "wrap-search",
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_num = 1,
@@ -1872,7 +1931,7 @@ const struct options_table_entry options_table[] = {
 		  "bottom."
 	},
 
-	{ .name = "xterm-keys", /* no longer used */
+	[OPTION_XTERM_KEYS] = { .name = "xterm-keys", /* no longer used */
 	  .type = OPTIONS_TABLE_FLAG,
 	  .scope = OPTIONS_TABLE_WINDOW,
 	  .default_num = 1,
@@ -1881,86 +1940,86 @@ const struct options_table_entry options_table[] = {
 	},
 
 	/* Hook options. */
-	OPTIONS_TABLE_HOOK("after-bind-key", ""),
-	OPTIONS_TABLE_HOOK("after-capture-pane", ""),
-	OPTIONS_TABLE_HOOK("after-copy-mode", ""),
-	OPTIONS_TABLE_HOOK("after-display-message", ""),
-	OPTIONS_TABLE_HOOK("after-display-panes", ""),
-	OPTIONS_TABLE_HOOK("after-kill-pane", ""),
-	OPTIONS_TABLE_HOOK("after-list-buffers", ""),
-	OPTIONS_TABLE_HOOK("after-list-clients", ""),
-	OPTIONS_TABLE_HOOK("after-list-keys", ""),
-	OPTIONS_TABLE_HOOK("after-list-panes", ""),
-	OPTIONS_TABLE_HOOK("after-list-sessions", ""),
-	OPTIONS_TABLE_HOOK("after-list-windows", ""),
-	OPTIONS_TABLE_HOOK("after-load-buffer", ""),
-	OPTIONS_TABLE_HOOK("after-lock-server", ""),
-	OPTIONS_TABLE_HOOK("after-new-session", ""),
-	OPTIONS_TABLE_HOOK("after-new-window", ""),
-	OPTIONS_TABLE_HOOK("after-paste-buffer", ""),
-	OPTIONS_TABLE_HOOK("after-pipe-pane", ""),
-	OPTIONS_TABLE_HOOK("after-queue", ""),
-	OPTIONS_TABLE_HOOK("after-refresh-client", ""),
-	OPTIONS_TABLE_HOOK("after-rename-session", ""),
-	OPTIONS_TABLE_HOOK("after-rename-window", ""),
-	OPTIONS_TABLE_HOOK("after-resize-pane", ""),
-	OPTIONS_TABLE_HOOK("after-resize-window", ""),
-	OPTIONS_TABLE_HOOK("after-save-buffer", ""),
-	OPTIONS_TABLE_HOOK("after-select-layout", ""),
-	OPTIONS_TABLE_HOOK("after-select-pane", ""),
-	OPTIONS_TABLE_HOOK("after-select-window", ""),
-	OPTIONS_TABLE_HOOK("after-send-keys", ""),
-	OPTIONS_TABLE_HOOK("after-set-buffer", ""),
-	OPTIONS_TABLE_HOOK("after-set-environment", ""),
-	OPTIONS_TABLE_HOOK("after-set-hook", ""),
-	OPTIONS_TABLE_HOOK("after-set-option", ""),
-	OPTIONS_TABLE_HOOK("after-show-environment", ""),
-	OPTIONS_TABLE_HOOK("after-show-messages", ""),
-	OPTIONS_TABLE_HOOK("after-show-options", ""),
-	OPTIONS_TABLE_HOOK("after-split-window", ""),
-	OPTIONS_TABLE_HOOK("after-unbind-key", ""),
-	OPTIONS_TABLE_HOOK("alert-activity", ""),
-	OPTIONS_TABLE_HOOK("alert-bell", ""),
-	OPTIONS_TABLE_HOOK("alert-silence", ""),
-	OPTIONS_TABLE_HOOK("client-active", ""),
-	OPTIONS_TABLE_HOOK("client-attached", ""),
-	OPTIONS_TABLE_HOOK("client-detached", ""),
-	OPTIONS_TABLE_HOOK("client-focus-in", ""),
-	OPTIONS_TABLE_HOOK("client-focus-out", ""),
-	OPTIONS_TABLE_HOOK("client-resized", ""),
-	OPTIONS_TABLE_HOOK("client-session-changed", ""),
-	OPTIONS_TABLE_HOOK("client-light-theme", ""),
-	OPTIONS_TABLE_HOOK("client-dark-theme", ""),
-	OPTIONS_TABLE_HOOK("command-error", ""),
-	OPTIONS_TABLE_HOOK("marked-pane-changed", ""),
-	OPTIONS_TABLE_PANE_HOOK("pane-command-finished", ""),
-	OPTIONS_TABLE_PANE_HOOK("pane-command-started", ""),
-	OPTIONS_TABLE_PANE_HOOK("pane-created", ""),
-	OPTIONS_TABLE_PANE_HOOK("pane-died", ""),
-	OPTIONS_TABLE_PANE_HOOK("pane-exited", ""),
-	OPTIONS_TABLE_PANE_HOOK("pane-focus-in", ""),
-	OPTIONS_TABLE_PANE_HOOK("pane-focus-out", ""),
-	OPTIONS_TABLE_PANE_HOOK("pane-mode-changed", ""),
-	OPTIONS_TABLE_PANE_HOOK("pane-mode-entered", ""),
-	OPTIONS_TABLE_PANE_HOOK("pane-mode-exited", ""),
-	OPTIONS_TABLE_PANE_HOOK("pane-prompt-closed", ""),
-	OPTIONS_TABLE_PANE_HOOK("pane-prompt-opened", ""),
-	OPTIONS_TABLE_PANE_HOOK("pane-resized", ""),
-	OPTIONS_TABLE_PANE_HOOK("pane-set-clipboard", ""),
-	OPTIONS_TABLE_PANE_HOOK("pane-shell-prompt", ""),
-	OPTIONS_TABLE_PANE_HOOK("pane-title-changed", ""),
-	OPTIONS_TABLE_HOOK("session-closed", ""),
-	OPTIONS_TABLE_HOOK("session-created", ""),
-	OPTIONS_TABLE_HOOK("session-renamed", ""),
-	OPTIONS_TABLE_HOOK("session-window-changed", ""),
-	OPTIONS_TABLE_WINDOW_HOOK("window-layout-changed", ""),
-	OPTIONS_TABLE_HOOK("window-linked", ""),
-	OPTIONS_TABLE_WINDOW_HOOK("window-pane-changed", ""),
-	OPTIONS_TABLE_WINDOW_HOOK("window-renamed", ""),
-	OPTIONS_TABLE_WINDOW_HOOK("window-resized", ""),
-	OPTIONS_TABLE_WINDOW_HOOK("window-unzoomed", ""),
-	OPTIONS_TABLE_WINDOW_HOOK("window-zoomed", ""),
-	OPTIONS_TABLE_HOOK("window-unlinked", ""),
-
-	{ .name = NULL }
+	[OPTION_AFTER_BIND_KEY] = OPTIONS_TABLE_HOOK("after-bind-key", ""),
+	[OPTION_AFTER_CAPTURE_PANE] = OPTIONS_TABLE_HOOK("after-capture-pane", ""),
+	[OPTION_AFTER_COPY_MODE] = OPTIONS_TABLE_HOOK("after-copy-mode", ""),
+	[OPTION_AFTER_DISPLAY_MESSAGE] = OPTIONS_TABLE_HOOK("after-display-message", ""),
+	[OPTION_AFTER_DISPLAY_PANES] = OPTIONS_TABLE_HOOK("after-display-panes", ""),
+	[OPTION_AFTER_KILL_PANE] = OPTIONS_TABLE_HOOK("after-kill-pane", ""),
+	[OPTION_AFTER_LIST_BUFFERS] = OPTIONS_TABLE_HOOK("after-list-buffers", ""),
+	[OPTION_AFTER_LIST_CLIENTS] = OPTIONS_TABLE_HOOK("after-list-clients", ""),
+	[OPTION_AFTER_LIST_KEYS] = OPTIONS_TABLE_HOOK("after-list-keys", ""),
+	[OPTION_AFTER_LIST_PANES] = OPTIONS_TABLE_HOOK("after-list-panes", ""),
+	[OPTION_AFTER_LIST_SESSIONS] = OPTIONS_TABLE_HOOK("after-list-sessions", ""),
+	[OPTION_AFTER_LIST_WINDOWS] = OPTIONS_TABLE_HOOK("after-list-windows", ""),
+	[OPTION_AFTER_LOAD_BUFFER] = OPTIONS_TABLE_HOOK("after-load-buffer", ""),
+	[OPTION_AFTER_LOCK_SERVER] = OPTIONS_TABLE_HOOK("after-lock-server", ""),
+	[OPTION_AFTER_NEW_SESSION] = OPTIONS_TABLE_HOOK("after-new-session", ""),
+	[OPTION_AFTER_NEW_WINDOW] = OPTIONS_TABLE_HOOK("after-new-window", ""),
+	[OPTION_AFTER_PASTE_BUFFER] = OPTIONS_TABLE_HOOK("after-paste-buffer", ""),
+	[OPTION_AFTER_PIPE_PANE] = OPTIONS_TABLE_HOOK("after-pipe-pane", ""),
+	[OPTION_AFTER_QUEUE] = OPTIONS_TABLE_HOOK("after-queue", ""),
+	[OPTION_AFTER_REFRESH_CLIENT] = OPTIONS_TABLE_HOOK("after-refresh-client", ""),
+	[OPTION_AFTER_RENAME_SESSION] = OPTIONS_TABLE_HOOK("after-rename-session", ""),
+	[OPTION_AFTER_RENAME_WINDOW] = OPTIONS_TABLE_HOOK("after-rename-window", ""),
+	[OPTION_AFTER_RESIZE_PANE] = OPTIONS_TABLE_HOOK("after-resize-pane", ""),
+	[OPTION_AFTER_RESIZE_WINDOW] = OPTIONS_TABLE_HOOK("after-resize-window", ""),
+	[OPTION_AFTER_SAVE_BUFFER] = OPTIONS_TABLE_HOOK("after-save-buffer", ""),
+	[OPTION_AFTER_SELECT_LAYOUT] = OPTIONS_TABLE_HOOK("after-select-layout", ""),
+	[OPTION_AFTER_SELECT_PANE] = OPTIONS_TABLE_HOOK("after-select-pane", ""),
+	[OPTION_AFTER_SELECT_WINDOW] = OPTIONS_TABLE_HOOK("after-select-window", ""),
+	[OPTION_AFTER_SEND_KEYS] = OPTIONS_TABLE_HOOK("after-send-keys", ""),
+	[OPTION_AFTER_SET_BUFFER] = OPTIONS_TABLE_HOOK("after-set-buffer", ""),
+	[OPTION_AFTER_SET_ENVIRONMENT] = OPTIONS_TABLE_HOOK("after-set-environment", ""),
+	[OPTION_AFTER_SET_HOOK] = OPTIONS_TABLE_HOOK("after-set-hook", ""),
+	[OPTION_AFTER_SET_OPTION] = OPTIONS_TABLE_HOOK("after-set-option", ""),
+	[OPTION_AFTER_SHOW_ENVIRONMENT] = OPTIONS_TABLE_HOOK("after-show-environment", ""),
+	[OPTION_AFTER_SHOW_MESSAGES] = OPTIONS_TABLE_HOOK("after-show-messages", ""),
+	[OPTION_AFTER_SHOW_OPTIONS] = OPTIONS_TABLE_HOOK("after-show-options", ""),
+	[OPTION_AFTER_SPLIT_WINDOW] = OPTIONS_TABLE_HOOK("after-split-window", ""),
+	[OPTION_AFTER_UNBIND_KEY] = OPTIONS_TABLE_HOOK("after-unbind-key", ""),
+	[OPTION_ALERT_ACTIVITY] = OPTIONS_TABLE_HOOK("alert-activity", ""),
+	[OPTION_ALERT_BELL] = OPTIONS_TABLE_HOOK("alert-bell", ""),
+	[OPTION_ALERT_SILENCE] = OPTIONS_TABLE_HOOK("alert-silence", ""),
+	[OPTION_CLIENT_ACTIVE] = OPTIONS_TABLE_HOOK("client-active", ""),
+	[OPTION_CLIENT_ATTACHED] = OPTIONS_TABLE_HOOK("client-attached", ""),
+	[OPTION_CLIENT_DETACHED] = OPTIONS_TABLE_HOOK("client-detached", ""),
+	[OPTION_CLIENT_FOCUS_IN] = OPTIONS_TABLE_HOOK("client-focus-in", ""),
+	[OPTION_CLIENT_FOCUS_OUT] = OPTIONS_TABLE_HOOK("client-focus-out", ""),
+	[OPTION_CLIENT_RESIZED] = OPTIONS_TABLE_HOOK("client-resized", ""),
+	[OPTION_CLIENT_SESSION_CHANGED] = OPTIONS_TABLE_HOOK("client-session-changed", ""),
+	[OPTION_CLIENT_LIGHT_THEME] = OPTIONS_TABLE_HOOK("client-light-theme", ""),
+	[OPTION_CLIENT_DARK_THEME] = OPTIONS_TABLE_HOOK("client-dark-theme", ""),
+	[OPTION_COMMAND_ERROR] = OPTIONS_TABLE_HOOK("command-error", ""),
+	[OPTION_MARKED_PANE_CHANGED] = OPTIONS_TABLE_HOOK("marked-pane-changed", ""),
+	[OPTION_PANE_COMMAND_FINISHED] = OPTIONS_TABLE_PANE_HOOK("pane-command-finished", ""),
+	[OPTION_PANE_COMMAND_STARTED] = OPTIONS_TABLE_PANE_HOOK("pane-command-started", ""),
+	[OPTION_PANE_CREATED] = OPTIONS_TABLE_PANE_HOOK("pane-created", ""),
+	[OPTION_PANE_DIED] = OPTIONS_TABLE_PANE_HOOK("pane-died", ""),
+	[OPTION_PANE_EXITED] = OPTIONS_TABLE_PANE_HOOK("pane-exited", ""),
+	[OPTION_PANE_FOCUS_IN] = OPTIONS_TABLE_PANE_HOOK("pane-focus-in", ""),
+	[OPTION_PANE_FOCUS_OUT] = OPTIONS_TABLE_PANE_HOOK("pane-focus-out", ""),
+	[OPTION_PANE_MODE_CHANGED] = OPTIONS_TABLE_PANE_HOOK("pane-mode-changed", ""),
+	[OPTION_PANE_MODE_ENTERED] = OPTIONS_TABLE_PANE_HOOK("pane-mode-entered", ""),
+	[OPTION_PANE_MODE_EXITED] = OPTIONS_TABLE_PANE_HOOK("pane-mode-exited", ""),
+	[OPTION_PANE_PROMPT_CLOSED] = OPTIONS_TABLE_PANE_HOOK("pane-prompt-closed", ""),
+	[OPTION_PANE_PROMPT_OPENED] = OPTIONS_TABLE_PANE_HOOK("pane-prompt-opened", ""),
+	[OPTION_PANE_RESIZED] = OPTIONS_TABLE_PANE_HOOK("pane-resized", ""),
+	[OPTION_PANE_SET_CLIPBOARD] = OPTIONS_TABLE_PANE_HOOK("pane-set-clipboard", ""),
+	[OPTION_PANE_SHELL_PROMPT] = OPTIONS_TABLE_PANE_HOOK("pane-shell-prompt", ""),
+	[OPTION_PANE_TITLE_CHANGED] = OPTIONS_TABLE_PANE_HOOK("pane-title-changed", ""),
+	[OPTION_SESSION_CLOSED] = OPTIONS_TABLE_HOOK("session-closed", ""),
+	[OPTION_SESSION_CREATED] = OPTIONS_TABLE_HOOK("session-created", ""),
+	[OPTION_SESSION_RENAMED] = OPTIONS_TABLE_HOOK("session-renamed", ""),
+	[OPTION_SESSION_WINDOW_CHANGED] = OPTIONS_TABLE_HOOK("session-window-changed", ""),
+	[OPTION_WINDOW_LAYOUT_CHANGED] = OPTIONS_TABLE_WINDOW_HOOK("window-layout-changed", ""),
+	[OPTION_WINDOW_LINKED] = OPTIONS_TABLE_HOOK("window-linked", ""),
+	[OPTION_WINDOW_PANE_CHANGED] = OPTIONS_TABLE_WINDOW_HOOK("window-pane-changed", ""),
+	[OPTION_WINDOW_RENAMED] = OPTIONS_TABLE_WINDOW_HOOK("window-renamed", ""),
+	[OPTION_WINDOW_RESIZED] = OPTIONS_TABLE_WINDOW_HOOK("window-resized", ""),
+	[OPTION_WINDOW_UNZOOMED] = OPTIONS_TABLE_WINDOW_HOOK("window-unzoomed", ""),
+	[OPTION_WINDOW_ZOOMED] = OPTIONS_TABLE_WINDOW_HOOK("window-zoomed", ""),
+	[OPTION_WINDOW_UNLINKED] = OPTIONS_TABLE_HOOK("window-unlinked", ""),
+
+	[OPTION_COUNT] = { .name = NULL }
 };
@@ -115,7 +115,28 @@ struct options_entry {
 struct options {
 	RB_HEAD(options_tree, options_entry)	 tree;
 	struct options				*parent;
+
+	uint64_t				 generation;
+	struct options_entry		       **cache;
+	uint64_t				 cache_generation;
+};
+
+/*
+ * Each option in the table is identified by its index, which is also its
+ * OPTION_* ID. Names (and their other names) are mapped to this ID by a hash
+ * table, and each set of options keeps an array by ID of the entries it
+ * resolves to, including from its parents. When an option is added or removed
+ * or the parent is changed, the set of options is given a new generation; the
+ * array is thrown away if the set or any of its parents has a generation newer
+ * than the array.
+ */
+struct options_id {
+	const char	*name;
+	u_int		 id;
 };
+static struct options_id	*options_ids;
+static u_int			 options_ids_size;
+static uint64_t			 options_generation;
 
 static struct options_entry	*options_add(struct options *, const char *);
 static void			 options_remove(struct options_entry *);
@@ -159,6 +180,68 @@ options_map_name(const char *name)
 	return (name);
 }
 
+static u_int
+options_id_hash(const char *name)
+{
+	u_int	hash = 2166136261U;
+
+	for (; *name != '\0'; name++) {
+		hash ^= (u_char)*name;
+		hash *= 16777619U;
+	}
+	return (hash);
+}
+
+static void
+options_add_id(const char *name, u_int id)
+{
+	u_int	slot;
+
+	slot = options_id_hash(name) & (options_ids_size - 1);
+	while (options_ids[slot].name != NULL)
+		slot = (slot + 1) & (options_ids_size - 1);
+	options_ids[slot].name = name;
+	options_ids[slot].id = id;
+}
+
+/* Get the ID of a table option by name, or -1 if it is not in the table. */
+static int
+options_find_id(const char *name)
+{
+	const struct options_table_entry	*oe;
+	const struct options_name_map		*map;
+	u_int					 slot, n = 0;
+	int					 id;
+
+	if (options_ids == NULL) {
+		for (oe = options_table; oe->name != NULL; oe++)
+			/* nothing */;
+		if (oe - options_table != OPTION_COUNT)
+			fatalx("option table has wrong size");
+		for (map = options_other_names; map->from != NULL; map++)
+			n++;
+		options_ids_size = 64;
+		while (options_ids_size < (OPTION_COUNT + n) * 4)
+			options_ids_size *= 2;
+		options_ids = xcalloc(options_ids_size, sizeof *options_ids);
+
+		for (oe = options_table; oe->name != NULL; oe++)
+			options_add_id(oe->name, oe - options_table);
+		for (map = options_other_names; map->from != NULL; map++) {
+			if ((id = options_find_id(map->to)) != -1)
+				options_add_id(map->from, id);
+		}
+	}
+
+	slot = options_id_hash(name) & (options_ids_size - 1);
+	while (options_ids[slot].name != NULL) {
+		if (strcmp(options_ids[slot].name, name) == 0)
+			return (options_ids[slot].id);
+		slot = (slot + 1) & (options_ids_size - 1);
+	}
+	return (-1);
+}
+
 static const struct options_table_entry *
 options_parent_table_entry(struct options *oo, const char *s)
 {
@@ -237,6 +320,7 @@ options_free(struct options *oo)
 
 	RB_FOREACH_SAFE(o, options_tree, &oo->tree, tmp)
 		options_remove(o);
+	free(oo->cache);
 	free(oo);
 }
 
@@ -250,6 +334,7 @@ void
 options_set_parent(struct options *oo, struct options *parent)
 {
 	oo->parent = parent;
+	oo->generation = ++options_generation;
 }
 
 struct options_entry *
@@ -277,8 +362,8 @@ options_get_only(struct options *oo, const char *name)
 	return (found);
 }
 
-struct options_entry *
-options_get(struct options *oo, const char *name)
+static struct options_entry *
+options_get_uncached(struct options *oo, const char *name)
 {
 	struct options_entry	*o;
 
@@ -292,6 +377,41 @@ options_get(struct options *oo, const char *name)
 	return (o);
 }
 
+/* Get a table option by ID, using the cache if it is still valid. */
+struct options_entry *
+options_get_id(struct options *oo, enum options_table_id id)
+{
+	struct options		*loop;
+	struct options_entry	*o;
+
+	for (loop = oo; loop != NULL; loop = loop->parent) {
+		if (loop->generation > oo->cache_generation)
+			break;
+	}
+	if (loop != NULL || oo->cache == NULL) {
+		if (oo->cache == NULL)
+			oo->cache = xcalloc(OPTION_COUNT, sizeof *oo->cache);
+		else
+			memset(oo->cache, 0, OPTION_COUNT * sizeof *oo->cache);
+		oo->cache_generation = options_generation;
+	} else if ((o = oo->cache[id]) != NULL)
+		return (o);
+
+	o = options_get_uncached(oo, options_table[id].name);
+	oo->cache[id] = o;
+	return (o);
+}
+
+struct options_entry *
+options_get(struct options *oo, const char *name)
+{
+	int	id;
+
+	if ((id = options_find_id(name)) == -1)
+		return (options_get_uncached(oo, name));
+	return (options_get_id(oo, id));
+}
+
 struct options_entry *
 options_empty(struct options *oo, const struct options_table_entry *oe)
 {
@@ -397,6 +517,7 @@ options_add(struct options *oo, const char *name)
 	o->name = xstrdup(name);
 
 	RB_INSERT(options_tree, &oo->tree, o);
+	oo->generation = ++options_generation;
 	return (o);
 }
 
@@ -412,6 +533,7 @@ options_remove(struct options_entry *o)
 	if (o->monitor_data != NULL)
 		notify_monitor_free(o->monitor_data);
 	RB_REMOVE(options_tree, &oo->tree, o);
+	oo->generation = ++options_generation;
 	free((void *)o->name);
 	free(o);
 }
@@ -890,6 +1012,32 @@ options_get_number(struct options *oo, const char *name)
 	return (o->value.number);
 }
 
+const char *
+options_get_string_id(struct options *oo, enum options_table_id id)
+{
+	struct options_entry	*o;
+
+	o = options_get_id(oo, id);
+	if (o == NULL)
+		fatalx("missing option %s", options_table[id].name);
+	if (!OPTIONS_IS_STRING(o))
+		fatalx("option %s is not a string", options_table[id].name);
+	return (o->value.string);
+}
+
+long long
+options_get_number_id(struct options *oo, enum options_table_id id)
+{
+	struct options_entry	*o;
+
+	o = options_get_id(oo, id);
+	if (o == NULL)
+		fatalx("missing option %s", options_table[id].name);
+	if (!OPTIONS_IS_NUMBER(o))
+		fatalx("option %s is not a number", options_table[id].name);
+	return (o->value.number);
+}
+
 struct cmd_list *
 options_get_command(struct options *oo, const char *name)
 {
@@ -1427,6 +1575,10 @@ options_push_changes(const char *name)
 		RB_FOREACH(wp, window_pane_tree, &all_window_panes)
 			window_pane_scrollbar_hide(wp);
 	}
+	if (strcmp(name, "pane-memory-limit") == 0) {
+		RB_FOREACH(wp, window_pane_tree, &all_window_panes)
+			window_pane_check_memory(wp);
+	}
 	if (strcmp(name, "pane-scrollbars-style") == 0) {
 		RB_FOREACH(wp, window_pane_tree, &all_window_panes) {
 			style_set_scrollbar_style_from_option(
@@ -1437,8 +1589,16 @@ options_push_changes(const char *name)
 	}
 	if (strcmp(name, "codepoint-widths") == 0)
 		utf8_update_width_cache();
+	if (strcmp(name, "log-buffer-lines") == 0)
+		log_set_buffer(options_get_number(global_options, name));
 	if (strcmp(name, "input-buffer-size") == 0)
 		input_set_buffer_size(options_get_number(global_options, name));
+	if (strcmp(name, "allocation-stats") == 0)
+		stats_set_allocations(options_get_number(global_options, name));
+	if (strcmp(name, "stall-threshold") == 0) {
+		stats_set_stall_threshold(options_get_number(global_options,
+		    name));
+	}
 	if (strcmp(name, "history-limit") == 0) {
 		RB_FOREACH(s, sessions, &sessions)
 			session_update_history(s);
@@ -20,8 +20,10 @@
 #include <sys/stat.h>
 #include <sys/param.h>
 
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 #include "tmux.h"
@@ -29,34 +31,42 @@
 char *
 osdep_get_name(int fd, __unused char *tty)
 {
-	FILE	*f;
-	char	*path, *buf;
+	char	*path, *buf, *end;
 	size_t	 len;
-	int	 ch;
+	ssize_t	 n;
+	int	 f;
 	pid_t	 pgrp;
 
 	if ((pgrp = tcgetpgrp(fd)) == -1)
 		return (NULL);
 
 	xasprintf(&path, "/proc/%lld/cmdline", (long long) pgrp);
-	if ((f = fopen(path, "r")) == NULL) {
+	if ((f = open(path, O_RDONLY)) == -1) {
 		free(path);
 		return (NULL);
 	}
 	free(path);
 
+	/* Only the first argument is needed, so stop at the first NUL. */
 	len = 0;
 	buf = NULL;
-	while ((ch = fgetc(f)) != EOF) {
-		if (ch == '\0')
+	for (;;) {
+		buf = xrealloc(buf, len + 256 + 1);
+		if ((n = read(f, buf + len, 256)) <= 0)
 			break;
-		buf = xrealloc(buf, len + 2);
-		buf[len++] = ch;
+		if ((end = memchr(buf + len, '\0', n)) != NULL) {
+			len = end - buf;
+			break;
+		}
+		len += n;
 	}
-	if (buf != NULL)
-		buf[len] = '\0';
+	close(f);
 
-	fclose(f);
+	if (len == 0) {
+		free(buf);
+		return (NULL);
+	}
+	buf[len] = '\0';
 	return (buf);
 }
 
@@ -91,12 +101,10 @@ osdep_get_cwd(int fd)
 struct event_base *
 osdep_event_init(void)
 {
-	struct event_base	*base;
-
-	/* On Linux, epoll doesn't work on /dev/null (yes, really). */
-	setenv("EVENT_NOEPOLL", "1", 1);
-
-	base = event_init();
-	unsetenv("EVENT_NOEPOLL");
-	return (base);
+	/*
+	 * On Linux, epoll doesn't work on /dev/null (yes, really) or regular
+	 * files. These are given to proc_bufferevent_new which moves them to
+	 * a separate poll base.
+	 */
+	return (event_init());
 }
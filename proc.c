@@ -18,6 +18,7 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/uio.h>
 #include <sys/utsname.h>
 
@@ -69,6 +70,13 @@ struct tmuxpeer {
 };
 
 static int	peer_check_version(struct tmuxpeer *, struct imsg *);
+
+/*
+ * Base for file descriptors which cannot be polled by every backend, such as
+ * /dev/null or regular files with epoll. These are always ready, so it uses
+ * poll and is run without blocking after each main loop iteration.
+ */
+static struct event_base	*proc_fallback_base;
 static void	proc_update_event(struct tmuxpeer *);
 
 static void
@@ -206,16 +214,95 @@ proc_start(const char *name)
 	return (tp);
 }
 
+static void
+proc_fallback_callback(__unused int fd, __unused short events,
+    __unused void *arg)
+{
+}
+
+/* Run any events on the fallback base. */
+static void
+proc_fallback_loop(void)
+{
+	struct timeval	tv = { .tv_sec = 0 };
+
+	if (proc_fallback_base == NULL)
+		return;
+	if (event_base_loop(proc_fallback_base,
+	    EVLOOP_NONBLOCK|EVLOOP_ONCE) != 0)
+		return; /* no events */
+
+	/* There may be more to do, so make sure the main loop wakes up. */
+	event_once(-1, EV_TIMEOUT, proc_fallback_callback, NULL, &tv);
+}
+
 void
 proc_loop(struct tmuxproc *tp, int (*loopcb)(void))
 {
 	log_debug("%s loop enter", tp->name);
-	do
+	for (;;) {
 		event_loop(EVLOOP_ONCE);
-	while (!tp->exit && (loopcb == NULL || !loopcb ()));
+		if (tp->exit || (loopcb != NULL && loopcb()))
+			break;
+		proc_fallback_loop();
+	}
 	log_debug("%s loop exit", tp->name);
 }
 
+/*
+ * Check if a file descriptor can be polled. Regular files and /dev/null are
+ * always ready and some backends (epoll) refuse them.
+ */
+static int
+proc_fd_pollable(int fd)
+{
+	struct stat	sb, null_sb;
+
+	if (fstat(fd, &sb) != 0)
+		return (1);
+	if (S_ISREG(sb.st_mode) || S_ISDIR(sb.st_mode))
+		return (0);
+	if (S_ISCHR(sb.st_mode) &&
+	    stat(_PATH_DEVNULL, &null_sb) == 0 &&
+	    sb.st_rdev == null_sb.st_rdev)
+		return (0);
+	return (1);
+}
+
+/*
+ * Create a bufferevent for a file descriptor which may not be pollable, using
+ * the fallback base if necessary.
+ */
+struct bufferevent *
+proc_bufferevent_new(int fd, bufferevent_data_cb readcb,
+    bufferevent_data_cb writecb, bufferevent_event_cb errorcb, void *arg)
+{
+	struct bufferevent	*bev;
+	struct event_config	*config;
+
+	bev = bufferevent_new(fd, readcb, writecb, errorcb, arg);
+	if (bev == NULL || proc_fd_pollable(fd))
+		return (bev);
+
+	if (proc_fallback_base == NULL) {
+		config = event_config_new();
+		event_config_avoid_method(config, "epoll");
+		event_config_avoid_method(config, "kqueue");
+		event_config_avoid_method(config, "devpoll");
+		event_config_avoid_method(config, "evport");
+		proc_fallback_base = event_base_new_with_config(config);
+		event_config_free(config);
+		if (proc_fallback_base == NULL)
+			fatalx("event_base_new_with_config failed");
+		log_debug("fallback event base using %s",
+		    event_base_get_method(proc_fallback_base));
+	}
+	log_debug("fd %d not pollable, using fallback event base", fd);
+	if (bufferevent_base_set(proc_fallback_base, bev) != 0)
+		fatalx("bufferevent_base_set failed");
+	return (bev);
+}
+
 void
 proc_exit(struct tmuxproc *tp)
 {
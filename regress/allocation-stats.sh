@@ -0,0 +1,40 @@
+#!/bin/sh
+
+# show-stats -m shows the grid memory for each pane and, when allocation-stats
+# is on, the allocations made by each file.
+
+PATH=/bin:/usr/bin
+TERM=screen
+LC_ALL=C.UTF-8
+export TERM LC_ALL
+
+[ -z "$TEST_TMUX" ] && TEST_TMUX=$(readlink -f ../tmux)
+TMUX="$TEST_TMUX -Ltest$$ -f/dev/null"
+
+trap "$TMUX kill-server 2>/dev/null" 0 1 15
+
+fail() {
+	echo "$*" >&2
+	exit 1
+}
+
+$TMUX kill-server 2>/dev/null
+$TMUX new -d -x80 -y20 "seq 1000; sleep 100" || exit 1
+sleep 1
+
+out=$($TMUX show-stats -m) || exit 1
+echo "$out" | grep -q '^Allocations: not counted$' || \
+	fail "allocations counted when off"
+p='^Pane %0: memory=[1-9][0-9]* bytes, grid=[1-9][0-9]* bytes, history=98[0-9] '
+echo "$out" | grep -q "$p" || fail "no grid memory for pane"
+
+$TMUX set -s allocation-stats on \; splitw "seq 1000; sleep 100" || exit 1
+sleep 1
+
+out=$($TMUX show-stats -m) || exit 1
+echo "$out" | grep -q '^Allocations: count=[1-9]' || fail "no allocations"
+echo "$out" | grep -q '^Allocations grid: count=[1-9][0-9]* ([0-9]*/s), bytes=[1-9]' || \
+	fail "no allocations for grid"
+echo "$out" | grep -q '^Pane %1: memory=[1-9]' || fail "no grid memory for new pane"
+
+exit 0
@@ -0,0 +1,29 @@
+#!/bin/sh
+
+# Control clients and file streams using /dev/null or regular files, which
+# some event backends cannot poll.
+
+PATH=/bin:/usr/bin
+TERM=screen
+
+[ -z "$TEST_TMUX" ] && TEST_TMUX=$(readlink -f ../tmux)
+TMUX="$TEST_TMUX -LtestA$$ -f/dev/null"
+$TMUX kill-server 2>/dev/null
+
+TMP=$(mktemp -d)
+trap "$TMUX kill-server 2>/dev/null; rm -rf $TMP" 0 1 15
+
+$TMUX -f/dev/null new -d -x40 -y10 || exit 1
+
+printf 'display -p hello\n' >$TMP/in
+timeout 10 $TMUX -C a <$TMP/in >$TMP/out || exit 1
+grep -q '^hello$' $TMP/out || exit 1
+timeout 10 $TMUX -C a </dev/null >/dev/null || exit 1
+
+echo test >$TMP/in
+timeout 10 $TMUX loadb - <$TMP/in || exit 1
+timeout 10 $TMUX saveb - >$TMP/out || exit 1
+cmp -s $TMP/in $TMP/out || exit 1
+timeout 10 $TMUX loadb - </dev/null || exit 1
+
+exit 0
@@ -0,0 +1,43 @@
+#!/bin/sh
+
+# The time taken for keys typed into a client to be echoed by a pane is
+# recorded for each client and shown by show-stats.
+
+PATH=/bin:/usr/bin
+TERM=screen
+LC_ALL=C.UTF-8
+export TERM LC_ALL
+
+[ -z "$TEST_TMUX" ] && TEST_TMUX=$(readlink -f ../tmux)
+TMUX="$TEST_TMUX -LtestA$$ -f/dev/null"
+TMUX2="$TEST_TMUX -LtestB$$ -f/dev/null"
+
+trap "$TMUX kill-server 2>/dev/null; $TMUX2 kill-server 2>/dev/null" 0 1 15
+
+fail() {
+	echo "$*" >&2
+	exit 1
+}
+
+$TMUX kill-server 2>/dev/null
+$TMUX2 kill-server 2>/dev/null
+
+$TMUX2 new -d -x40 -y10 "cat" || exit 1
+$TMUX new -d -x40 -y11 "$TMUX2 attach" || exit 1
+sleep 1
+
+for key in a b c; do
+	$TMUX send -l $key || exit 1
+	sleep 0.5
+done
+sleep 1
+
+$TMUX2 capturep -p | grep -q '^abc$' || fail "keys not echoed"
+$TMUX2 show-stats | grep -q '^Echo time: count=3,' || \
+	fail "bad echo time"
+$TMUX2 show-stats | grep -q '^Echo pane time: count=3,' || \
+	fail "bad echo pane time"
+$TMUX2 show-stats | grep -q '^Client .* echo time: count=3,' || \
+	fail "bad client echo time"
+
+exit 0
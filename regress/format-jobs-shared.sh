@@ -0,0 +1,45 @@
+#!/bin/sh
+
+# Identical #() commands used by the status lines of several clients run as
+# one shared format job, reported by show-messages -J.
+
+PATH=/bin:/usr/bin
+TERM=screen
+LC_ALL=C.UTF-8
+export TERM LC_ALL
+
+[ -z "$TEST_TMUX" ] && TEST_TMUX=$(readlink -f ../tmux)
+TMUX="$TEST_TMUX -LtestA$$ -f/dev/null"
+TMUX2="$TEST_TMUX -LtestB$$ -f/dev/null"
+
+trap "$TMUX kill-server 2>/dev/null; $TMUX2 kill-server 2>/dev/null" 0 1 15
+
+fail() {
+	echo "$*" >&2
+	exit 1
+}
+
+$TMUX kill-server 2>/dev/null
+$TMUX2 kill-server 2>/dev/null
+
+$TMUX2 new -d -x40 -y10 || exit 1
+$TMUX2 set -g status-interval 60 || exit 1
+$TMUX2 set -g status-left-length 40 || exit 1
+$TMUX2 set -g status-left "[#(echo shared-job)]" || exit 1
+
+$TMUX new -d -x40 -y10 "$TMUX2 attach" || exit 1
+$TMUX set -g status off || exit 1
+$TMUX neww -d "$TMUX2 attach" || exit 1
+sleep 2
+
+for i in 0 1; do
+	$TMUX capturep -pt:$i | tail -1 | grep -q '^\[shared-job\]' || \
+		fail "client $i status missing job output"
+done
+
+out=$($TMUX2 show-messages -J | grep '^Format job .*: echo shared-job ')
+[ $(echo "$out" | wc -l) -eq 1 ] || fail "job not shared: $out"
+echo "$out" | grep -q 'users=2' || fail "wrong users: $out"
+echo "$out" | grep -q 'runs=1,' || fail "wrong runs: $out"
+
+exit 0
@@ -272,6 +272,11 @@ test_format "#{n:@greek}" "6"
 test_format "#{w:@greek}" "3"
 test_format "#{n:@cjk}" "6"
 test_format "#{w:@cjk}" "4"
+# Long ASCII runs on either side of wide characters.
+$TMUX set -g @mixed 'abcdefghijklmnop中文qrstuvwxyz0123456789' || exit 1
+test_format "#{n:@mixed}" "42"
+test_format "#{w:@mixed}" "40"
+test_format "#{p42:@mixed}" "abcdefghijklmnop中文qrstuvwxyz0123456789  "
 
 
 # --- basename and dirname ------------------------------------------------
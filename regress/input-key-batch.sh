@@ -0,0 +1,33 @@
+#!/bin/sh
+
+# Keys arriving together are batched, but keys after one which runs a key
+# binding must still see its effect.
+
+PATH=/bin:/usr/bin
+TERM=screen
+export TERM
+
+[ -z "$TEST_TMUX" ] && TEST_TMUX=$(readlink -f ../tmux)
+TMUX="$TEST_TMUX -LtestA$$ -f/dev/null"
+TMUX2="$TEST_TMUX -LtestB$$ -f/dev/null"
+
+TMP=$(mktemp -d)
+trap "$TMUX kill-server 2>/dev/null; $TMUX2 kill-server 2>/dev/null; \
+	rm -rf $TMP" 0 1 15
+
+$TMUX kill-server 2>/dev/null
+$TMUX2 kill-server 2>/dev/null
+
+$TMUX2 new -d -x40 -y10 "stty raw -echo; cat >$TMP/out1" || exit 1
+$TMUX2 bind c neww "stty raw -echo; cat >$TMP/out2" || exit 1
+$TMUX new -d -x40 -y10 "$TMUX2 attach" || exit 1
+$TMUX set -g status off || exit 1
+sleep 1
+
+$TMUX send -l "abc$(printf '\002')cdef" || exit 1
+sleep 1
+
+[ "$(cat $TMP/out1)" = "abc" ] || exit 1
+[ "$(cat $TMP/out2)" = "def" ] || exit 1
+
+exit 0
@@ -0,0 +1,39 @@
+#!/bin/sh
+
+# Log messages are kept in memory up to log-buffer-lines and shown by
+# show-messages -L.
+
+PATH=/bin:/usr/bin
+TERM=screen
+LC_ALL=C.UTF-8
+export TERM LC_ALL
+
+[ -z "$TEST_TMUX" ] && TEST_TMUX=$(readlink -f ../tmux)
+TMUX="$TEST_TMUX -Ltest$$ -f/dev/null"
+
+trap "$TMUX kill-server 2>/dev/null" 0 1 15
+
+fail() {
+	echo "$*" >&2
+	exit 1
+}
+
+$TMUX kill-server 2>/dev/null
+$TMUX new -d -x40 -y10 || exit 1
+
+n=$($TMUX showmsgs -L | wc -l)
+[ "$n" -eq 0 ] || fail "$n messages kept with no buffer"
+
+$TMUX set -s log-buffer-lines 1000 || exit 1
+$TMUX neww -d || exit 1
+$TMUX showmsgs -L | grep -q 'new-window' || fail "command not logged"
+
+$TMUX set -s log-buffer-lines 20 || exit 1
+n=$($TMUX showmsgs -L | wc -l)
+[ "$n" -eq 20 ] || fail "$n messages kept, expected 20"
+
+$TMUX set -s log-buffer-lines 0 || exit 1
+n=$($TMUX showmsgs -L | wc -l)
+[ "$n" -eq 0 ] || fail "$n messages kept after buffer removed"
+
+exit 0
@@ -0,0 +1,49 @@
+#!/bin/sh
+
+# Mouse motion events arriving together are collapsed into the latest one,
+# unless mouse-coalesce is off or the pane wants all motion events.
+
+PATH=/bin:/usr/bin
+TERM=screen
+LC_ALL=C.UTF-8
+export TERM LC_ALL
+
+[ -z "$TEST_TMUX" ] && TEST_TMUX=$(readlink -f ../tmux)
+TMUX="$TEST_TMUX -LtestA$$ -f/dev/null"
+TMUX2="$TEST_TMUX -LtestB$$ -f/dev/null"
+
+TMP=$(mktemp -d)
+trap "rm -rf $TMP; $TMUX kill-server 2>/dev/null; $TMUX2 kill-server 2>/dev/null" 0 1 15
+
+fail() {
+	echo "$*" >&2
+	exit 1
+}
+
+# check $mode $expected: start a pane with mouse mode $mode, drag through it
+# and check the events it sees.
+check() {
+	rm -f $TMP/out
+	$TMUX2 respawnp -k -t:0 \
+		"printf '\033[?$1h\033[?1006h'; stty raw -echo; cat >$TMP/out"
+	sleep 1
+	$TMUX send -l -t:0 "$(printf '\033[<0;2;2M\033[<32;3;2M\033[<32;4;2M\033[<32;5;2M\033[<0;5;2m')"
+	sleep 1
+	out=$(cat -v $TMP/out)
+	[ "$out" = "$2" ] || fail "mode $1: got $out, expected $2"
+}
+
+$TMUX kill-server 2>/dev/null
+$TMUX2 kill-server 2>/dev/null
+
+$TMUX2 new -d -x40 -y10 || exit 1
+$TMUX new -d -x40 -y10 "$TMUX2 attach" || exit 1
+sleep 1
+
+all='^[[<0;2;2M^[[<32;3;2M^[[<32;4;2M^[[<32;5;2M^[[<0;5;2m'
+check 1002 '^[[<0;2;2M^[[<32;5;2M^[[<0;5;2m'
+check 1003 "$all"
+$TMUX2 set -g mouse-coalesce off || exit 1
+check 1002 "$all"
+
+exit 0
@@ -0,0 +1,22 @@
+#!/bin/sh
+
+# pane_current_path and pane_current_command are cached but must follow a
+# process that changes directory and prints something.
+
+PATH=/bin:/usr/bin
+TERM=screen
+
+[ -z "$TEST_TMUX" ] && TEST_TMUX=$(readlink -f ../tmux)
+TMUX="$TEST_TMUX -Ltest$$ -f/dev/null"
+$TMUX kill-server 2>/dev/null
+trap "$TMUX kill-server 2>/dev/null" 0 1 15
+
+$TMUX new -d "cd /; sleep 3; cd /tmp; echo; exec sleep 100" || exit 1
+sleep 1
+[ "$($TMUX display -p '#{pane_current_path}')" = "/" ] || exit 1
+sleep 4
+[ "$($TMUX display -p '#{pane_current_path}')" = "/tmp" ] || exit 1
+sleep 5
+[ "$($TMUX display -p '#{pane_current_command}')" = "sleep" ] || exit 1
+
+exit 0
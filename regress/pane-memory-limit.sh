@@ -0,0 +1,45 @@
+#!/bin/sh
+
+# A pane over pane-memory-limit loses its oldest history but keeps the newest
+# output.
+
+PATH=/bin:/usr/bin
+TERM=screen
+LC_ALL=C.UTF-8
+export TERM LC_ALL
+
+[ -z "$TEST_TMUX" ] && TEST_TMUX=$(readlink -f ../tmux)
+TMUX="$TEST_TMUX -Ltest$$ -f/dev/null"
+
+trap "$TMUX kill-server 2>/dev/null" 0 1 15
+
+fail() {
+	echo "$*" >&2
+	exit 1
+}
+
+$TMUX kill-server 2>/dev/null
+$TMUX -f/dev/null new -d -x80 -y20 "sleep 1; seq 100000; sleep 100" \; \
+	set -g history-limit 200000 \; \
+	set -p pane-memory-limit 500000 \; \
+	splitw -d "sleep 1; seq 100000; sleep 100" || exit 1
+sleep 3
+
+h0=$($TMUX display -p -t%0 '#{history_size}')
+h1=$($TMUX display -p -t%1 '#{history_size}')
+[ "$h0" -lt 10000 ] || fail "history not trimmed: $h0 lines"
+[ "$h1" -gt 90000 ] || fail "history trimmed without limit: $h1 lines"
+
+last=$($TMUX capturep -p -t%0 | grep . | tail -1)
+[ "$last" = "100000" ] || fail "last line is $last"
+
+mem=$($TMUX show-stats -m | sed -n 's/^Pane %0: memory=\([0-9]*\) .*/\1/p')
+[ -n "$mem" ] && [ "$mem" -le 500000 ] || fail "pane using $mem bytes"
+
+# Setting the limit applies it straight away, and it may be over 2 GiB.
+$TMUX set -p -t%1 pane-memory-limit 500000 || exit 1
+h1=$($TMUX display -p -t%1 '#{history_size}')
+[ "$h1" -lt 10000 ] || fail "history not trimmed after set: $h1 lines"
+$TMUX set -p -t%1 pane-memory-limit 5000000000 || fail "limit over 2 GiB"
+
+exit 0
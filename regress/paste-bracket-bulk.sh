@@ -0,0 +1,43 @@
+#!/bin/sh
+
+# Bracket pasted text is given to the pane as a block but must arrive
+# unchanged, including control characters and split end sequences.
+
+PATH=/bin:/usr/bin
+TERM=screen
+LC_ALL=C.UTF-8
+export TERM LC_ALL
+
+[ -z "$TEST_TMUX" ] && TEST_TMUX=$(readlink -f ../tmux)
+TMUX="$TEST_TMUX -LtestA$$ -f/dev/null"
+TMUX2="$TEST_TMUX -LtestB$$ -f/dev/null"
+
+TMP=$(mktemp -d)
+trap "$TMUX kill-server 2>/dev/null; $TMUX2 kill-server 2>/dev/null; \
+	rm -rf $TMP" 0 1 15
+
+$TMUX kill-server 2>/dev/null
+$TMUX2 kill-server 2>/dev/null
+
+$TMUX2 new -d -x40 -y10 "stty raw -echo; cat >$TMP/out" || exit 1
+$TMUX new -d -x40 -y10 "$TMUX2 attach" || exit 1
+$TMUX set -g status off || exit 1
+sleep 1
+
+i=0
+while [ $i -lt 500 ]; do
+	printf 'line %d: some text\t\001 ✓\r' $i
+	i=$((i + 1))
+done >$TMP/in
+
+$TMUX send -l "$(printf '\033[200~')" || exit 1
+$TMUX send -l "$(cat $TMP/in)" || exit 1
+$TMUX send -l "$(printf '\033[20')" || exit 1
+sleep 0.2
+$TMUX send -l '1~after' || exit 1
+sleep 2
+
+printf 'after' >>$TMP/in
+cmp -s $TMP/in $TMP/out || exit 1
+
+exit 0
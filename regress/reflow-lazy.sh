@@ -0,0 +1,52 @@
+#!/bin/sh
+
+# Resizing a pane with a large history only reflows the newest lines at once.
+# Check the whole history is still intact when it is captured or searched in
+# copy mode after several resizes.
+
+PATH=/bin:/usr/bin
+TERM=screen
+LC_ALL=C.UTF-8
+export TERM LC_ALL
+
+[ -z "$TEST_TMUX" ] && TEST_TMUX=$(readlink -f ../tmux)
+TMUX="$TEST_TMUX -Ltest$$ -f/dev/null"
+
+TMP=$(mktemp -d)
+trap "rm -rf $TMP; $TMUX kill-server 2>/dev/null" 0 1 15
+
+fail() {
+	echo "$*" >&2
+	exit 1
+}
+
+# Lines of varying length, many wider than the pane.
+awk 'BEGIN {
+	for (i = 0; i < 5000; i++) {
+		s = i ":"
+		for (j = 0; j < (i * 37) % 230; j++)
+			s = s sprintf("%c", 97 + (i + j) % 26)
+		print s
+	}
+}' >$TMP/in
+
+$TMUX kill-server 2>/dev/null
+$TMUX -f/dev/null new -d -x80 -y20 "cat $TMP/in; sleep 100" \; \
+	set -g history-limit 100000 || exit 1
+sleep 2
+
+$TMUX capturep -pJ -S- | sed 's/ *$//' >$TMP/before
+for x in 50 120 37 200 80; do
+	$TMUX resizew -x $x || exit 1
+done
+$TMUX capturep -pJ -S- | sed 's/ *$//' >$TMP/after
+cmp -s $TMP/before $TMP/after || fail "history changed after resize"
+
+$TMUX resizew -x 45 || exit 1
+$TMUX copy-mode \; send -X history-top \; send -X search-forward '^10:' || \
+	exit 1
+line=$($TMUX display -p '#{copy_cursor_line}')
+[ "$line" = "10:klmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz" ] || \
+	fail "wrong line in copy mode: $line"
+
+exit 0
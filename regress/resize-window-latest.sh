@@ -0,0 +1,43 @@
+#!/bin/sh
+
+# A client whose size changes many times in quick succession leaves its
+# window at the last size once the changes stop.
+
+PATH=/bin:/usr/bin
+TERM=screen
+LC_ALL=C.UTF-8
+export TERM LC_ALL
+
+[ -z "$TEST_TMUX" ] && TEST_TMUX=$(readlink -f ../tmux)
+TMUX="$TEST_TMUX -LtestA$$ -f/dev/null"
+TMUX2="$TEST_TMUX -LtestB$$ -f/dev/null"
+
+trap "$TMUX kill-server 2>/dev/null; $TMUX2 kill-server 2>/dev/null" 0 1 15
+
+fail() {
+	echo "$*" >&2
+	exit 1
+}
+
+$TMUX kill-server 2>/dev/null
+$TMUX2 kill-server 2>/dev/null
+
+$TMUX2 new -d -x40 -y10 || exit 1
+$TMUX new -d -x80 -y20 "$TMUX2 attach" || exit 1
+sleep 1
+
+tty=$($TMUX display -p '#{pane_tty}')
+pid=$($TMUX2 display -p '#{client_pid}')
+[ -n "$tty" ] && [ -n "$pid" ] || fail "no client"
+
+for x in 79 77 75 73 71 69 67 65 63 61 60; do
+	stty cols $x <$tty || exit 1
+	kill -WINCH $pid
+	sleep 0.02
+done
+sleep 1
+
+size=$($TMUX2 display -p '#{window_width}x#{window_height}')
+[ "$size" = "60x19" ] || fail "window is $size, expected 60x19"
+
+exit 0
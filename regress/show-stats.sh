@@ -0,0 +1,36 @@
+#!/bin/sh
+
+# Statistics are kept for each pane and shown by show-stats and formats.
+
+PATH=/bin:/usr/bin
+TERM=screen
+LC_ALL=C.UTF-8
+export TERM LC_ALL
+
+[ -z "$TEST_TMUX" ] && TEST_TMUX=$(readlink -f ../tmux)
+TMUX="$TEST_TMUX -Ltest$$ -f/dev/null"
+
+trap "$TMUX kill-server 2>/dev/null" 0 1 15
+
+fail() {
+	echo "$*" >&2
+	exit 1
+}
+
+$TMUX kill-server 2>/dev/null
+$TMUX new -d -x40 -y10 "printf abcdef; sleep 100" || exit 1
+$TMUX neww -d "printf 0123456789; sleep 100" || exit 1
+sleep 1
+
+out=$($TMUX display -p -t:0 '#{pane_input_bytes},#{pane_cells_written}')
+[ "$out" = "6,6" ] || fail "pane 0 stats are $out, expected 6,6"
+out=$($TMUX display -p -t:1 '#{pane_input_bytes},#{pane_cells_written}')
+[ "$out" = "10,10" ] || fail "pane 1 stats are $out, expected 10,10"
+out=$($TMUX display -p '#{session_input_bytes}')
+[ "$out" = "16" ] || fail "session stats are $out, expected 16"
+
+$TMUX show-stats | grep -q '^Input: 16 bytes$' || fail "bad total input"
+$TMUX show-stats | grep -q '^Pane %1: input=10, cells=10$' || \
+	fail "bad pane in show-stats"
+
+exit 0
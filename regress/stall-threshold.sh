@@ -0,0 +1,37 @@
+#!/bin/sh
+
+# Commands which take longer than stall-threshold are recorded as stalls with
+# their name and target pane.
+
+PATH=/bin:/usr/bin
+TERM=screen
+LC_ALL=C.UTF-8
+export TERM LC_ALL
+
+[ -z "$TEST_TMUX" ] && TEST_TMUX=$(readlink -f ../tmux)
+TMUX="$TEST_TMUX -Ltest$$ -f/dev/null"
+
+trap "$TMUX kill-server 2>/dev/null" 0 1 15
+
+fail() {
+	echo "$*" >&2
+	exit 1
+}
+
+$TMUX kill-server 2>/dev/null
+$TMUX new -d -x40 -y10 "seq 200000; sleep 100" \; \
+	set -g history-limit 300000 || exit 1
+sleep 2
+
+$TMUX set -g stall-threshold 0 || exit 1
+$TMUX capturep -p -S- >/dev/null || exit 1
+$TMUX show-stats | grep -q 'command capture-pane' && \
+	fail "stall recorded with threshold 0"
+
+$TMUX set -g stall-threshold 1 || exit 1
+$TMUX capturep -p -S- >/dev/null || exit 1
+$TMUX show-stats | grep -q '^Stall at .*: [0-9]*ms, command capture-pane, client .*, pane %0$' || \
+	fail "stall not recorded"
+$TMUX show-stats | grep -q '^Stalls: [1-9]' || fail "stall not counted"
+
+exit 0
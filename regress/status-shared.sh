@@ -0,0 +1,67 @@
+#!/bin/sh
+
+# Two clients attached to the same session with the same width share one
+# rendered status line. Check that both still show the right content, that
+# client-specific formats are kept apart, and that the remaining client keeps
+# updating after the other detaches.
+
+PATH=/bin:/usr/bin
+TERM=screen
+LC_ALL=C.UTF-8
+export TERM LC_ALL
+
+[ -z "$TEST_TMUX" ] && TEST_TMUX=$(readlink -f ../tmux)
+TMUX="$TEST_TMUX -LtestA$$ -f/dev/null"
+TMUX2="$TEST_TMUX -LtestB$$ -f/dev/null"
+
+trap "$TMUX kill-server 2>/dev/null; $TMUX2 kill-server 2>/dev/null" 0 1 15
+
+fail() {
+	echo "$*" >&2
+	exit 1
+}
+
+# status_of $pane: print the last line of an outer pane.
+status_of() {
+	$TMUX capturep -pt"$1" | tail -1
+}
+
+$TMUX kill-server 2>/dev/null
+$TMUX2 kill-server 2>/dev/null
+
+$TMUX2 new -d -x40 -y10 || exit 1
+$TMUX2 set -g status-right "" || exit 1
+$TMUX2 set -g status-left-length 40 || exit 1
+$TMUX2 set -g window-status-format "" || exit 1
+$TMUX2 set -g window-status-current-format "" || exit 1
+$TMUX2 set -g status-left "[shared]" || exit 1
+
+$TMUX new -d -x40 -y10 "$TMUX2 attach" || exit 1
+$TMUX set -g status off || exit 1
+$TMUX set -g window-size manual || exit 1
+$TMUX neww -d "$TMUX2 attach" || exit 1
+sleep 1
+
+s0=$(status_of :0)
+s1=$(status_of :1)
+echo "$s0" | grep -q '^\[shared\]' || fail "client 0 status: $s0"
+[ "$s0" = "$s1" ] || fail "shared status differs: '$s0' '$s1'"
+
+# A client-specific format must not be shared.
+$TMUX2 set -g status-left "[#{client_tty}]" || exit 1
+sleep 1
+s0=$(status_of :0)
+s1=$(status_of :1)
+[ "$s0" != "$s1" ] || fail "client status not separate: '$s0'"
+
+# Back to a shared line, then detach one client and update again.
+$TMUX2 set -g status-left "[shared]" || exit 1
+sleep 1
+$TMUX send -t:1 C-b d || exit 1
+sleep 1
+$TMUX2 set -g status-left "[after]" || exit 1
+sleep 1
+s0=$(status_of :0)
+echo "$s0" | grep -q '^\[after\]' || fail "status not updated: $s0"
+
+exit 0
@@ -0,0 +1,52 @@
+#!/bin/sh
+
+# Characters of more than three bytes no longer used by any pane are freed and
+# their indexes reused. Fill a pane with many different characters, clear it
+# and draw more, then check both it and another pane show the right
+# characters.
+
+PATH=/bin:/usr/bin
+TERM=screen
+LC_ALL=C.UTF-8
+export TERM LC_ALL
+
+[ -z "$TEST_TMUX" ] && TEST_TMUX=$(readlink -f ../tmux)
+TMUX="$TEST_TMUX -Ltest$$ -f/dev/null"
+
+TMP=$(mktemp -d)
+trap "$TMUX kill-server 2>/dev/null; rm -rf $TMP" 0 1 15
+
+fail() {
+	echo "$*" >&2
+	exit 1
+}
+
+# Print $2 characters of four bytes starting at $1, twenty on each line.
+cat <<'END' >$TMP/chars.sh
+LC_ALL=C awk -vstart=$1 -vcount=$2 'BEGIN {
+	for (i = 0; i < count; i++) {
+		c = start + i
+		printf "%c%c%c%c", 240 + int(c / 262144),
+		    128 + int(c / 4096) % 64, 128 + int(c / 64) % 64,
+		    128 + c % 64
+		if (i % 20 == 19)
+			printf "\n"
+	}
+}'
+END
+
+$TMUX kill-server 2>/dev/null
+$TMUX new -d -x40 -y20 "sh $TMP/chars.sh 131072 40; cat" || exit 1
+$TMUX set -g history-limit 0 || exit 1
+$TMUX splitw -d "sh $TMP/chars.sh 135168 4000; printf '\033[H\033[2J'; \
+	sleep 1; sh $TMP/chars.sh 139264 100; cat" || exit 1
+sleep 3
+
+sh $TMP/chars.sh 131072 40 >$TMP/expect0
+sh $TMP/chars.sh 139264 100 >$TMP/expect1
+$TMUX capturep -pt.0 | head -2 >$TMP/got0
+$TMUX capturep -pt.1 | head -5 >$TMP/got1
+cmp -s $TMP/expect0 $TMP/got0 || fail "first pane is wrong"
+cmp -s $TMP/expect1 $TMP/got1 || fail "second pane is wrong"
+
+exit 0
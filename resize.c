@@ -410,6 +410,8 @@ recalculate_size(struct window *w, int now)
 		w->new_sy = sy;
 		w->new_xpixel = xpixel;
 		w->new_ypixel = ypixel;
+		w->resize_previous = w->resize_changed;
+		w->resize_changed = get_timer();
 
 		w->flags |= WINDOW_RESIZE;
 		tty_update_window_offset(w);
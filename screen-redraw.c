@@ -289,7 +289,8 @@ redraw_set_context(struct client *c, struct redraw_build_ctx *bctx)
 	bctx->w = w;
 	redraw_get_window_offset(c, &bctx->ox, &bctx->oy, &bctx->sx, &bctx->sy);
 
-	bctx->ind = options_get_number(w->options, "pane-border-indicators");
+	bctx->ind = options_get_number_id(w->options,
+	    OPTION_PANE_BORDER_INDICATORS);
 }
 
 /* Return a cell. */
@@ -1093,7 +1094,8 @@ redraw_get_default_border_style(struct redraw_draw_ctx *dctx,
 		memcpy(dgc, &grid_default_cell, sizeof *dgc);
 		style_add(dgc, oo, "pane-border-style", ft);
 		format_free(ft);
-		dctx->pane_lines = options_get_number(oo, "pane-border-lines");
+		dctx->pane_lines = options_get_number_id(oo,
+		    OPTION_PANE_BORDER_LINES);
 		dctx->flags |= REDRAW_DEFAULT_SET;
 	}
 	memcpy(gc, dgc, sizeof *gc);
@@ -1513,7 +1515,7 @@ redraw_set_draw_context(struct redraw_draw_ctx *dctx,
 	dctx->active = server_client_get_pane(c);
 
 	lines = status_line_size(c);
-	if (options_get_number(oo, "status-position") == 0)
+	if (options_get_number_id(oo, OPTION_STATUS_POSITION) == 0)
 		dctx->flags |= REDRAW_STATUS_TOP;
 	dctx->status_lines = lines;
 
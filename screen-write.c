@@ -427,7 +427,7 @@ screen_write_reset(struct screen_write_ctx *ctx)
 
 	s->mode = MODE_CURSOR|MODE_WRAP;
 
-	if (options_get_number(global_options, "extended-keys") == 2)
+	if (options_get_number_id(global_options, OPTION_EXTENDED_KEYS) == 2)
 		s->mode = (s->mode & ~EXTENDED_KEY_MODES)|MODE_KEYS_EXTENDED;
 
 	screen_write_clearscreen(ctx, 8);
@@ -1920,7 +1920,7 @@ screen_write_clearendofscreen(struct screen_write_ctx *ctx, u_int bg)
 	    s->cy == 0 &&
 	    (gd->flags & GRID_HISTORY) &&
 	    ctx->wp != NULL &&
-	    options_get_number(ctx->wp->options, "scroll-on-clear"))
+	    options_get_number_id(ctx->wp->options, OPTION_SCROLL_ON_CLEAR))
 		grid_view_clear_history(gd, bg);
 	else {
 		if (s->cx <= sx - 1)
@@ -2072,7 +2072,7 @@ screen_write_clearscreen(struct screen_write_ctx *ctx, u_int bg)
 	/* Scroll into history if it is enabled. */
 	if ((s->grid->flags & GRID_HISTORY) &&
 	    ctx->wp != NULL &&
-	    options_get_number(ctx->wp->options, "scroll-on-clear"))
+	    options_get_number_id(ctx->wp->options, OPTION_SCROLL_ON_CLEAR))
 		grid_view_clear_history(s->grid, bg);
 	else
 		grid_view_clear(s->grid, 0, 0, sx, sy, bg);
@@ -2375,6 +2375,9 @@ screen_write_collect_flush_line(struct screen_write_ctx *ctx, u_int y)
 				ttyctx.data.size = w_length;
 				tty_write(tty_cmd_cells, &ttyctx);
 			}
+			if (wp != NULL)
+				wp->cells_written += w_length;
+			global_stats.cells += w_length;
 			items++;
 			written = 1;
 		}
@@ -2825,7 +2828,8 @@ screen_write_combine(struct screen_write_ctx *ctx, const struct grid_cell *gc)
 		zero_width = 1;
 	else if (utf8_is_vs(ud)) {
 		zero_width = 1;
-		if (options_get_number(oo, "variation-selector-always-wide"))
+		if (options_get_number_id(oo,
+		    OPTION_VARIATION_SELECTOR_ALWAYS_WIDE))
 			force_wide = 1;
 	} else if (ud->width == 0)
 		zero_width = 1;
@@ -3105,7 +3109,8 @@ screen_write_alternateon(struct screen_write_ctx *ctx, struct grid_cell *gc,
 	struct tty_ctx			 ttyctx;
 	struct window_pane		*wp = ctx->wp;
 
-	if (wp != NULL && !options_get_number(wp->options, "alternate-screen"))
+	if (wp != NULL &&
+	    !options_get_number_id(wp->options, OPTION_ALTERNATE_SCREEN))
 		return;
 
 	screen_write_collect_flush(ctx, 0, __func__);
@@ -3137,7 +3142,8 @@ screen_write_alternateoff(struct screen_write_ctx *ctx, struct grid_cell *gc,
 	struct tty_ctx		 ttyctx;
 	struct window_pane	*wp = ctx->wp;
 
-	if (wp != NULL && !options_get_number(wp->options, "alternate-screen"))
+	if (wp != NULL &&
+	    !options_get_number_id(wp->options, OPTION_ALTERNATE_SCREEN))
 		return;
 
 	screen_write_collect_flush(ctx, 0, __func__);
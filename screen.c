@@ -18,6 +18,10 @@
 
 #include <sys/types.h>
 
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+#include <signal.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
@@ -49,8 +53,36 @@ struct screen_title_entry {
 };
 TAILQ_HEAD(screen_titles, screen_title_entry);
 
+/*
+ * Reflow waiting to be done. Between screen_reflow_start and screen_reflow_end,
+ * reflows of grids with GRID_LAZYREFLOW are queued and then all done together,
+ * on several threads if there are enough lines and threads are available.
+ */
+struct screen_reflow_job {
+	struct screen			*s;
+	u_int				 sx;
+	int				 cursor;
+	u_int				 wx;
+	u_int				 wy;
+
+	TAILQ_ENTRY(screen_reflow_job)	 entry;
+};
+static TAILQ_HEAD(, screen_reflow_job) screen_reflow_jobs =
+    TAILQ_HEAD_INITIALIZER(screen_reflow_jobs);
+static u_int			 screen_reflow_depth;
+static struct screen_reflow_job	*screen_reflow_next;
+#ifdef HAVE_PTHREAD
+static pthread_mutex_t		 screen_reflow_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* Minimum lines to reflow before using threads, and maximum threads. */
+#define SCREEN_REFLOW_THREAD_LINES 10000
+#define SCREEN_REFLOW_THREADS 8
+
 static void	screen_resize_y(struct screen *, u_int, int, u_int *);
 static void	screen_reflow(struct screen *, u_int, u_int *, u_int *, int);
+static void	screen_reflow_queue(struct screen *, u_int, u_int, u_int, int);
+static void	screen_reflow_flush(struct screen *);
 
 /* Free titles stack. */
 static void
@@ -160,6 +192,7 @@ screen_free(struct screen *s)
 	if (s->write_list != NULL)
 		screen_write_free_list(s);
 
+	screen_reflow_flush(s);
 	if (SCREEN_IS_ALTERNATE(s))
 		grid_destroy(s->saved_grid);
 	grid_destroy(s->grid);
@@ -340,7 +373,20 @@ void
 screen_resize_cursor(struct screen *s, u_int sx, u_int sy, int reflow,
     int eat_empty, int cursor)
 {
-	u_int	cx = s->cx, cy = s->grid->hsize + s->cy;
+	struct grid	*gd = s->grid;
+	u_int		 cx, cy;
+
+	screen_reflow_flush(s);
+
+	/*
+	 * If growing could pull lines which have not been reflowed yet out of
+	 * the history, reflow them first.
+	 */
+	if (sy > screen_size_y(s) &&
+	    gd->reflow_y + (sy - screen_size_y(s)) > gd->hsize)
+		grid_reflow_finish(gd);
+	cx = s->cx;
+	cy = gd->hsize + s->cy;
 
 	if (s->write_list != NULL)
 		screen_write_free_list(s);
@@ -367,7 +413,14 @@ screen_resize_cursor(struct screen *s, u_int sx, u_int sy, int reflow,
 	image_free_all(s);
 #endif
 
-	if (reflow)
+	if (reflow &&
+	    screen_reflow_depth != 0 &&
+	    (s->grid->flags & GRID_LAZYREFLOW)) {
+		/* Leave the cursor where it is until the reflow is done. */
+		screen_reflow_queue(s, sx, cx, cy, cursor);
+		if (cx > sx - 1)
+			cx = sx - 1;
+	} else if (reflow)
 		screen_reflow(s, sx, &cx, &cy, cursor);
 
 	if (cy >= s->grid->hsize) {
@@ -670,6 +723,160 @@ screen_reflow(struct screen *s, u_int new_x, u_int *cx, u_int *cy, int cursor)
 	}
 }
 
+/* Queue a reflow until screen_reflow_end. */
+static void
+screen_reflow_queue(struct screen *s, u_int sx, u_int cx, u_int cy,
+    int cursor)
+{
+	struct screen_reflow_job	*job;
+
+	job = xcalloc(1, sizeof *job);
+	job->s = s;
+	job->sx = sx;
+	job->cursor = cursor;
+	if (cursor)
+		grid_wrap_position(s->grid, cx, cy, &job->wx, &job->wy);
+	TAILQ_INSERT_TAIL(&screen_reflow_jobs, job, entry);
+}
+
+/* Finish a queued reflow once the grid has been reflowed. */
+static void
+screen_reflow_done(struct screen_reflow_job *job)
+{
+	struct screen	*s = job->s;
+	u_int		 cx, cy;
+
+	if (job->cursor)
+		grid_unwrap_position(s->grid, &cx, &cy, job->wx, job->wy);
+	else {
+		cx = 0;
+		cy = s->grid->hsize;
+	}
+	if (cy >= s->grid->hsize) {
+		s->cx = cx;
+		s->cy = cy - s->grid->hsize;
+	} else {
+		s->cx = 0;
+		s->cy = 0;
+	}
+	log_debug("%s: cursor finished at %u,%u = %u,%u", __func__, s->cx,
+	    s->cy, cx, cy);
+
+	TAILQ_REMOVE(&screen_reflow_jobs, job, entry);
+	free(job);
+}
+
+/* Do any queued reflow for a screen now. */
+static void
+screen_reflow_flush(struct screen *s)
+{
+	struct screen_reflow_job	*job;
+
+	TAILQ_FOREACH(job, &screen_reflow_jobs, entry) {
+		if (job->s == s)
+			break;
+	}
+	if (job == NULL)
+		return;
+	grid_reflow(s->grid, job->sx);
+	screen_reflow_done(job);
+}
+
+/* Reflow thread, takes jobs until there are none left. */
+static void *
+screen_reflow_thread(__unused void *arg)
+{
+	struct screen_reflow_job	*job;
+
+	for (;;) {
+#ifdef HAVE_PTHREAD
+		pthread_mutex_lock(&screen_reflow_mutex);
+#endif
+		job = screen_reflow_next;
+		if (job != NULL)
+			screen_reflow_next = TAILQ_NEXT(job, entry);
+#ifdef HAVE_PTHREAD
+		pthread_mutex_unlock(&screen_reflow_mutex);
+#endif
+		if (job == NULL)
+			break;
+		grid_reflow(job->s->grid, job->sx);
+	}
+	return (NULL);
+}
+
+/* Start queueing reflows. */
+void
+screen_reflow_start(void)
+{
+	screen_reflow_depth++;
+}
+
+/*
+ * Do all queued reflows. The grids are independent, so if there are several
+ * with enough lines, they are reflowed on threads (if available) while this
+ * waits.
+ */
+void
+screen_reflow_end(void)
+{
+	struct screen_reflow_job	*job, *job1;
+	u_int				 jobs = 0, lines = 0;
+#ifdef HAVE_PTHREAD
+	pthread_t			 threads[SCREEN_REFLOW_THREADS];
+	sigset_t			 set, oldset;
+	u_int				 n = 0, i;
+	long				 cpus;
+#endif
+
+	if (screen_reflow_depth == 0 || --screen_reflow_depth != 0)
+		return;
+	if (TAILQ_EMPTY(&screen_reflow_jobs))
+		return;
+
+	TAILQ_FOREACH(job, &screen_reflow_jobs, entry) {
+		jobs++;
+		lines += job->s->grid->hsize + job->s->grid->sy;
+	}
+#ifdef HAVE_PTHREAD
+	if (jobs > 1 && lines >= SCREEN_REFLOW_THREAD_LINES) {
+		cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		if (cpus > SCREEN_REFLOW_THREADS)
+			cpus = SCREEN_REFLOW_THREADS;
+		if (cpus > (long)jobs)
+			cpus = jobs;
+		n = (cpus > 1) ? cpus - 1 : 0;
+	}
+	log_debug("%s: %u reflows of %u lines, %u threads", __func__, jobs,
+	    lines, n);
+
+	/* Signals must go to the main thread. */
+	screen_reflow_next = TAILQ_FIRST(&screen_reflow_jobs);
+	sigfillset(&set);
+	pthread_sigmask(SIG_BLOCK, &set, &oldset);
+	for (i = 0; i < n; i++) {
+		if (pthread_create(&threads[i], NULL, screen_reflow_thread,
+		    NULL) != 0)
+			break;
+	}
+	n = i;
+	pthread_sigmask(SIG_SETMASK, &oldset, NULL);
+
+	screen_reflow_thread(NULL);
+	for (i = 0; i < n; i++)
+		pthread_join(threads[i], NULL);
+#else
+	log_debug("%s: %u reflows of %u lines", __func__, jobs, lines);
+
+	/* No threads, so do them all here. */
+	screen_reflow_next = TAILQ_FIRST(&screen_reflow_jobs);
+	screen_reflow_thread(NULL);
+#endif
+
+	TAILQ_FOREACH_SAFE(job, &screen_reflow_jobs, entry, job1)
+		screen_reflow_done(job);
+}
+
 /*
  * Enter alternative screen mode. A copy of the visible screen is saved and the
  * history is not updated.
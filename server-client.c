@@ -461,6 +461,7 @@ server_client_lost(struct client *c)
 
 	TAILQ_REMOVE(&clients, c, entry);
 	log_debug("lost client %p", c);
+	stats_echo_cancel(c);
 
 	if (c->flags & CLIENT_ATTACHED) {
 		server_client_attached_lost(c);
@@ -1267,6 +1268,53 @@ server_client_is_assume_paste(struct client *c)
 	return (0);
 }
 
+/*
+ * Can bracket pasted text be given to the pane in one block rather than key
+ * by key? Not if it would go to an overlay or prompt instead.
+ */
+int
+server_client_can_bulk_paste(struct client *c)
+{
+	struct session		*s = c->session;
+	struct window_pane	*wp;
+
+	if (s == NULL || (c->flags & (CLIENT_UNATTACHEDFLAGS|CLIENT_READONLY)))
+		return (0);
+	if (c->message_string != NULL && c->message_ignore_keys)
+		return (0);
+	if (c->overlay_key != NULL || c->prompt != NULL)
+		return (0);
+	TAILQ_FOREACH(wp, &s->curw->window->panes, entry) {
+		if (window_pane_has_prompt(wp))
+			return (0);
+	}
+	return (1);
+}
+
+/*
+ * Can mouse motion events from this client be collapsed into the latest one?
+ * Not if turned off or if a pane in the current window is being sent all
+ * motion events.
+ */
+int
+server_client_can_coalesce_mouse(struct client *c)
+{
+	struct session		*s = c->session;
+	struct window_pane	*wp;
+
+	if (s == NULL || (c->flags & CLIENT_UNATTACHEDFLAGS))
+		return (0);
+	if (!options_get_number(s->options, "mouse-coalesce"))
+		return (0);
+	TAILQ_FOREACH(wp, &s->curw->window->panes, entry) {
+		if (!window_pane_is_visible(wp) || !TAILQ_EMPTY(&wp->modes))
+			continue;
+		if (wp->base.mode & MODE_MOUSE_ALL)
+			return (0);
+	}
+	return (1);
+}
+
 /* Has the latest client changed? */
 static void
 server_client_update_latest(struct client *c)
@@ -1309,12 +1357,13 @@ server_client_repeat_time(struct client *c, struct key_binding *bd)
 
 /*
  * Handle data key input from client. This owns and can modify the key event it
- * is given and is responsible for freeing it.
+ * is given and is responsible for freeing it. If commands were queued for a
+ * key binding, returns the last of them.
  */
-static enum cmd_retval
-server_client_key_callback(struct cmdq_item *item, void *data)
+static struct cmdq_item *
+server_client_key_event(struct cmdq_item *item, struct key_event *event,
+    int batched)
 {
-	struct key_event		*event = data;
 	struct client			*c, *ec = event->client;
 	key_code			 key = event->key;
 	struct mouse_event		*m = &event->m;
@@ -1328,6 +1377,7 @@ server_client_key_callback(struct cmdq_item *item, void *data)
 	u_int				 repeat;
 	uint64_t			 flags, prefix_delay;
 	struct cmd_find_state		 fs;
+	struct cmdq_item		*new_item = NULL;
 	key_code			 key0, prefix, prefix2;
 
 	if (ec != NULL)
@@ -1341,12 +1391,17 @@ server_client_key_callback(struct cmdq_item *item, void *data)
 		goto out;
 	wl = s->curw;
 
-	/* Update the activity timer. */
+	/*
+	 * Update the activity timer. Batched keys arrived together so use the
+	 * same time as the first.
+	 */
 	memcpy(&c->last_activity_time, &c->activity_time,
 	    sizeof c->last_activity_time);
-	if (gettimeofday(&c->activity_time, NULL) != 0)
-		fatal("gettimeofday failed");
-	session_update_activity(s, &c->activity_time);
+	if (!batched) {
+		if (gettimeofday(&c->activity_time, NULL) != 0)
+			fatal("gettimeofday failed");
+		session_update_activity(s, &c->activity_time);
+	}
 
 	/* Check for mouse keys. */
 	m->valid = 0;
@@ -1503,7 +1558,7 @@ try_again:
 		server_status_client(c);
 
 		/* Execute the key binding. */
-		key_bindings_dispatch(bd, item, c, event, &fs);
+		new_item = key_bindings_dispatch(bd, item, c, event, &fs);
 		key_bindings_unref_table(table);
 		goto out;
 	}
@@ -1567,8 +1622,15 @@ forward_key:
 	}
 	if (c->flags & CLIENT_READONLY)
 		goto out;
-	if (wp != NULL)
+	if (wp != NULL) {
 		window_pane_key(wp, c, s, wl, key, m);
+		if (event->time != 0 &&
+		    wp->fd != -1 &&
+		    (~wp->flags & PANE_INPUTOFF) &&
+		    !KEYC_IS_MOUSE(key) &&
+		    TAILQ_EMPTY(&wp->modes))
+			stats_echo_key(c, wp, event->time);
+	}
 	goto out;
 
 paste_key:
@@ -1586,9 +1648,55 @@ out:
 		server_client_unref(ec);
 	free(event->buf);
 	free(event);
+	return (new_item);
+}
+
+/*
+ * Handle a key or batch of keys. If a key runs a binding, the remaining keys
+ * are queued again after its commands.
+ */
+static enum cmd_retval
+server_client_key_callback(struct cmdq_item *item, void *data)
+{
+	struct key_event	*event = data, *next;
+	struct client		*c = cmdq_get_client(item);
+	struct cmdq_item	*after;
+	int			 batched = 0;
+
+	if (c != NULL)
+		c->key_batch = NULL;
+	do {
+		next = event->next;
+		event->next = NULL;
+		after = server_client_key_event(item, event, batched);
+		batched = 1;
+	} while ((event = next) != NULL && after == NULL);
+
+	if (event != NULL) {
+		log_debug("%s: requeuing batched keys", __func__);
+		cmdq_insert_after(after,
+		    cmdq_get_callback(server_client_key_callback, event));
+	}
 	return (CMD_RETURN_NORMAL);
 }
 
+/* Can this key be batched with the one before? */
+static int
+server_client_key_batchable(struct key_event *event)
+{
+	key_code	key = event->key;
+
+	if (event->client != NULL)
+		return (0);
+	if (key == KEYC_MOUSE || key == KEYC_DOUBLECLICK || KEYC_IS_MOUSE(key))
+		return (0);
+	if (KEYC_IS_PASTE(key))
+		return (0);
+	if (key == KEYC_FOCUS_IN || key == KEYC_FOCUS_OUT)
+		return (0);
+	return (1);
+}
+
 /* Handle a key event. */
 static int
 server_client_handle_key0(struct client *c, struct key_event *event,
@@ -1597,6 +1705,10 @@ server_client_handle_key0(struct client *c, struct key_event *event,
 	struct session		*s = c->session;
 	struct cmdq_item	*item;
 	struct window_pane	*wp;
+	struct key_event	*batch = c->key_batch;
+
+	/* Only keys queued one after another can be batched. */
+	c->key_batch = NULL;
 
 	/* Check the client is good to accept input. */
 	if (s == NULL || (c->flags & CLIENT_UNATTACHEDFLAGS))
@@ -1673,6 +1785,19 @@ server_client_handle_key0(struct client *c, struct key_event *event,
 		}
 	}
 
+	/*
+	 * If the previous key from the same read is still waiting in the
+	 * queue, add this one to it rather than queuing it separately.
+	 */
+	if (after == NULL &&
+	    batch != NULL &&
+	    server_client_key_batchable(event)) {
+		log_debug("%s: batching key %#llx", c->name, event->key);
+		batch->next = event;
+		c->key_batch = event;
+		return (1);
+	}
+
 	/*
 	 * Add the key to the queue so it happens after any commands queued by
 	 * previous keys.
@@ -1687,6 +1812,8 @@ server_client_handle_key0(struct client *c, struct key_event *event,
 		return (1);
 	}
 	cmdq_append(c, item);
+	if (server_client_key_batchable(event))
+		c->key_batch = event;
 	return (1);
 }
 
@@ -1762,11 +1889,28 @@ server_client_loop(void)
 	}
 }
 
-/* Check if window needs to be resized. */
+/* Window resize timer event. */
+static void
+server_client_window_resize_timer(__unused int fd, __unused short events,
+    void *data)
+{
+	struct window	*w = data;
+
+	log_debug("%s: @%u resize timer expired", __func__, w->id);
+	evtimer_del(&w->resize_timer);
+}
+
+/*
+ * Check if window needs to be resized. If the size is changing quickly (such
+ * as while a terminal is being dragged to a new size), wait until it has
+ * stopped changing and resize once to the latest size.
+ */
 static void
 server_client_check_window_resize(struct window *w)
 {
 	struct winlink	*wl;
+	struct timeval	 tv;
+	uint64_t	 t, since;
 
 	if (~w->flags & WINDOW_RESIZE)
 		return;
@@ -1778,6 +1922,23 @@ server_client_check_window_resize(struct window *w)
 	if (wl == NULL)
 		return;
 
+	t = get_timer();
+	since = t - w->resize_changed;
+	if (w->resize_changed - w->resize_previous < WINDOW_RESIZE_DELAY &&
+	    since < WINDOW_RESIZE_DELAY) {
+		if (!event_initialized(&w->resize_timer)) {
+			evtimer_set(&w->resize_timer,
+			    server_client_window_resize_timer, w);
+		}
+		if (!evtimer_pending(&w->resize_timer, NULL)) {
+			tv.tv_sec = 0;
+			tv.tv_usec = (WINDOW_RESIZE_DELAY - since) * 1000;
+			evtimer_add(&w->resize_timer, &tv);
+		}
+		log_debug("%s: delaying resize of window @%u", __func__, w->id);
+		return;
+	}
+
 	log_debug("%s: resizing window @%u", __func__, w->id);
 	resize_window(w, w->new_sx, w->new_sy, w->new_xpixel, w->new_ypixel);
 }
@@ -1933,8 +2094,12 @@ out:
 	 * If there is data remaining, and there are no clients able to consume
 	 * it, do not read any more. This is true when there are attached
 	 * clients, all of which are control clients which are not able to
-	 * accept any more data.
+	 * accept any more data. Also stop if the pane is over its memory limit
+	 * until the data is gone.
 	 */
+	if ((wp->flags & PANE_MEMORYLIMIT) &&
+	    window_pane_check_memory_stopped(wp))
+		off = 1;
 	log_debug("%s: pane %%%u is %s", __func__, wp->id, off ? "off" : "on");
 	if (off)
 		bufferevent_disable(wp->event, EV_READ);
@@ -2258,6 +2423,7 @@ server_client_check_redraw(struct client *c)
 	struct timeval		 tv = { .tv_usec = 1000 };
 	static struct event	 ev;
 	size_t			 n;
+	uint64_t		 t;
 
 	if (c->flags & (CLIENT_CONTROL|CLIENT_SUSPENDED))
 		return;
@@ -2304,6 +2470,13 @@ server_client_check_redraw(struct client *c)
 
 	/* Unfreeze the tty and turn off the cursor. */
 	log_debug("%s: redraw needed", c->name);
+	t = stats_time();
+	c->redraws++;
+	global_stats.redraws++;
+	if (c->flags & CLIENT_REDRAWWINDOW) {
+		c->full_redraws++;
+		global_stats.full_redraws++;
+	}
 	tflags = tty->flags & (TTY_BLOCK|TTY_FREEZE|TTY_NOCURSOR);
 	tty->flags = (tty->flags & ~(TTY_BLOCK|TTY_FREEZE))|TTY_NOCURSOR;
 
@@ -2350,6 +2523,8 @@ server_client_check_redraw(struct client *c)
 	c->flags &= ~(CLIENT_ALLREDRAWFLAGS|CLIENT_STATUSFORCE);
 	c->redraw = EVBUFFER_LENGTH(tty->out);
 	log_debug("%s: redraw added %zu bytes", c->name, c->redraw);
+
+	stats_add_time(&global_stats.redraw_time, t);
 }
 
 /* Set client title. */
@@ -265,6 +265,7 @@ server_loop(void)
 {
 	struct client	*c;
 	u_int		 items;
+	uint64_t	 t;
 
 	current_time = time(NULL);
 
@@ -276,7 +277,9 @@ server_loop(void)
 		}
 	} while (items != 0);
 
+	t = stats_time();
 	server_client_loop();
+	stats_stall(t, "server_client_loop", NULL, NULL, -1);
 
 	if (!options_get_number(global_options, "exit-empty") && !server_exit)
 		return (0);
@@ -0,0 +1,443 @@
+/* $OpenBSD$ */
+
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF MIND, USE, DATA OR PROFITS, WHETHER
+ * IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING
+ * OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+#include <sys/time.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "tmux.h"
+
+/*
+ * Counters and timings for the busiest parts of the server. Counters are
+ * simple increments; times are kept in histograms with a bucket for each
+ * power of two microseconds. Anything which takes longer than stall-threshold
+ * is also kept in a list of the most recent stalls.
+ */
+
+struct stats			 global_stats;
+static u_int			 stats_echo_pending;
+
+static struct stats_stall	 stats_stalls[STATS_STALLS];
+static u_int			 stats_stalls_next;
+static uint64_t			 stats_stall_threshold =
+				     STATS_STALL_DEFAULT * 1000ULL;
+
+static uint64_t			 stats_allocations_start;
+
+/* Get a timestamp in microseconds. */
+uint64_t
+stats_time(void)
+{
+	struct timespec	ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+		clock_gettime(CLOCK_REALTIME, &ts);
+	return ((ts.tv_sec * 1000000ULL) + (ts.tv_nsec / 1000ULL));
+}
+
+/* Add a time to a histogram. */
+void
+stats_add(struct stats_histogram *sh, uint64_t t)
+{
+	u_int	i;
+
+	sh->count++;
+	sh->total += t;
+	if (t > sh->max)
+		sh->max = t;
+
+	for (i = 0; i < STATS_BUCKETS - 1; i++) {
+		if (t < (1ULL << i))
+			break;
+	}
+	sh->buckets[i]++;
+}
+
+/* Add the time since a start timestamp to a histogram. */
+void
+stats_add_time(struct stats_histogram *sh, uint64_t start)
+{
+	stats_add(sh, stats_time() - start);
+}
+
+/*
+ * A key read from a client's terminal at time t has been written to a pane.
+ * Only one key is traced at a time, so if one is already waiting for its echo
+ * it is kept unless it has timed out.
+ */
+void
+stats_echo_key(struct client *c, struct window_pane *wp, uint64_t t)
+{
+	struct stats_echo	*se = &c->echo;
+	uint64_t		 now = stats_time();
+
+	if (se->key != 0) {
+		if (now - se->key < STATS_ECHO_TIMEOUT)
+			return;
+		stats_echo_pending--;
+	}
+	stats_echo_pending++;
+
+	se->pane = wp->id;
+	se->key = t;
+	se->written = now;
+	se->read = 0;
+}
+
+/*
+ * Output has been read from a pane, so record the time for any clients
+ * waiting for a key to be echoed if they can see it, or forget the key if not
+ * or if it has timed out.
+ */
+void
+stats_echo_read(struct window_pane *wp)
+{
+	struct client		*c;
+	struct stats_echo	*se;
+	uint64_t		 now = 0;
+
+	if (stats_echo_pending == 0)
+		return;
+	TAILQ_FOREACH(c, &clients, entry) {
+		se = &c->echo;
+		if (se->key == 0 || se->read != 0 || se->pane != wp->id)
+			continue;
+		if (c->session == NULL ||
+		    c->session->curw->window != wp->window) {
+			stats_echo_cancel(c);
+			continue;
+		}
+		if (now == 0)
+			now = stats_time();
+		if (now - se->key >= STATS_ECHO_TIMEOUT) {
+			stats_echo_cancel(c);
+			continue;
+		}
+		se->read = now;
+	}
+}
+
+/* Forget any key waiting to be echoed for a client. */
+void
+stats_echo_cancel(struct client *c)
+{
+	if (c->echo.key != 0) {
+		memset(&c->echo, 0, sizeof c->echo);
+		stats_echo_pending--;
+	}
+}
+
+/* Output has been written to a client, so any echo is complete. */
+void
+stats_echo_flush(struct client *c)
+{
+	struct stats		*st = &global_stats;
+	struct stats_echo	*se = &c->echo;
+	uint64_t		 now;
+
+	if (se->read == 0)
+		return;
+	now = stats_time();
+
+	stats_add(&c->echo_time, now - se->key);
+	stats_add(&st->echo_time, now - se->key);
+	stats_add(&st->echo_input_time, se->written - se->key);
+	stats_add(&st->echo_pane_time, se->read - se->written);
+	stats_add(&st->echo_output_time, now - se->read);
+	log_debug("%s: echo %%%u took %lluus (input %lluus, pane %lluus, "
+	    "output %lluus)", c->name, se->pane,
+	    (unsigned long long)(now - se->key),
+	    (unsigned long long)(se->written - se->key),
+	    (unsigned long long)(se->read - se->written),
+	    (unsigned long long)(now - se->read));
+
+	memset(se, 0, sizeof *se);
+	stats_echo_pending--;
+}
+
+/* Set the stall threshold in milliseconds, zero to turn it off. */
+void
+stats_set_stall_threshold(u_int threshold)
+{
+	stats_stall_threshold = threshold * 1000ULL;
+}
+
+/*
+ * Record something started at time start if it took longer than the stall
+ * threshold. The where argument is the function or type of item, what is the
+ * command or callback name.
+ */
+void
+stats_stall(uint64_t start, const char *where, const char *what,
+    struct client *c, int pane)
+{
+	struct stats_stall	*ss;
+	uint64_t		 t;
+	char			*text, *tmp;
+
+	if (stats_stall_threshold == 0)
+		return;
+	t = stats_time() - start;
+	if (t < stats_stall_threshold)
+		return;
+	global_stats.stalls++;
+
+	if (what != NULL)
+		xasprintf(&text, "%s %s", where, what);
+	else
+		text = xstrdup(where);
+	if (c != NULL && c->name != NULL) {
+		xasprintf(&tmp, "%s, client %s", text, c->name);
+		free(text);
+		text = tmp;
+	}
+	if (pane != -1) {
+		xasprintf(&tmp, "%s, pane %%%d", text, pane);
+		free(text);
+		text = tmp;
+	}
+	log_debug("stall: %s took %llums", text, (unsigned long long)t / 1000);
+
+	ss = &stats_stalls[stats_stalls_next++ % STATS_STALLS];
+	free(ss->text);
+	gettimeofday(&ss->time, NULL);
+	ss->duration = t;
+	ss->text = text;
+}
+
+/* Turn allocation accounting on or off. */
+void
+stats_set_allocations(int on)
+{
+	if (!on)
+		stats_allocations_start = 0;
+	else if (stats_allocations_start == 0)
+		stats_allocations_start = stats_time();
+	xmalloc_set_accounting(on);
+}
+
+/* Compare allocation tags by bytes allocated. */
+static int
+stats_cmp_tags(const void *a0, const void *b0)
+{
+	struct xmalloc_tag *const	*a = a0;
+	struct xmalloc_tag *const	*b = b0;
+	uint64_t			 ab, bb;
+
+	ab = __atomic_load_n(&(*a)->bytes, __ATOMIC_RELAXED);
+	bb = __atomic_load_n(&(*b)->bytes, __ATOMIC_RELAXED);
+	if (ab > bb)
+		return (-1);
+	if (ab < bb)
+		return (1);
+	return (strcmp((*a)->file, (*b)->file));
+}
+
+/* Print allocations for each file if they are being counted. */
+static void
+stats_print_allocations(struct cmdq_item *item)
+{
+	struct xmalloc_tag	*tag, **tags = NULL;
+	u_int			 ntags = 0, i;
+	uint64_t		 seconds, count, bytes;
+	const char		*file;
+	size_t			 len;
+
+	if (stats_allocations_start == 0) {
+		cmdq_print(item, "Allocations: not counted");
+		return;
+	}
+	seconds = (stats_time() - stats_allocations_start) / 1000000;
+	if (seconds == 0)
+		seconds = 1;
+
+	tag = __atomic_load_n(&xmalloc_tags, __ATOMIC_ACQUIRE);
+	for (; tag != NULL; tag = tag->next) {
+		tags = xreallocarray(tags, ntags + 1, sizeof *tags);
+		tags[ntags++] = tag;
+	}
+	if (ntags != 0)
+		qsort(tags, ntags, sizeof *tags, stats_cmp_tags);
+
+	count = bytes = 0;
+	for (i = 0; i < ntags; i++) {
+		count += __atomic_load_n(&tags[i]->count, __ATOMIC_RELAXED);
+		bytes += __atomic_load_n(&tags[i]->bytes, __ATOMIC_RELAXED);
+	}
+	cmdq_print(item, "Allocations: count=%llu, bytes=%llu, seconds=%llu",
+	    (unsigned long long)count, (unsigned long long)bytes,
+	    (unsigned long long)seconds);
+
+	for (i = 0; i < ntags; i++) {
+		tag = tags[i];
+		count = __atomic_load_n(&tag->count, __ATOMIC_RELAXED);
+		bytes = __atomic_load_n(&tag->bytes, __ATOMIC_RELAXED);
+		if (count == 0)
+			continue;
+
+		file = strrchr(tag->file, '/');
+		file = (file == NULL ? tag->file : file + 1);
+		len = strlen(file);
+		if (len > 2 && strcmp(file + len - 2, ".c") == 0)
+			len -= 2;
+		cmdq_print(item, "Allocations %.*s: count=%llu (%llu/s), "
+		    "bytes=%llu (%llu/s)", (int)len, file,
+		    (unsigned long long)count,
+		    (unsigned long long)(count / seconds),
+		    (unsigned long long)bytes,
+		    (unsigned long long)(bytes / seconds));
+	}
+	free(tags);
+}
+
+/* Print memory used by allocations, panes, images and paste buffers. */
+void
+stats_print_memory(struct cmdq_item *item)
+{
+	struct window_pane	*wp;
+	struct screen		*s;
+	struct paste_buffer	*pb;
+	size_t			 grid, total = 0, images = 0, size;
+	u_int			 buffers = 0;
+
+	stats_print_allocations(item);
+
+	RB_FOREACH(wp, window_pane_tree, &all_window_panes) {
+		s = &wp->base;
+		size = window_pane_memory(wp);
+		total += size;
+		grid = grid_memory(s->grid);
+		if (s->saved_grid != NULL)
+			grid += grid_memory(s->saved_grid);
+#ifdef ENABLE_SIXEL
+		images = image_memory(s);
+#endif
+		cmdq_print(item, "Pane %%%u: memory=%zu bytes, grid=%zu bytes, "
+		    "history=%u lines, images=%zu bytes%s", wp->id, size, grid,
+		    s->grid->hsize, images,
+		    (wp->flags & PANE_MEMORYLIMIT) ? ", stopped" : "");
+	}
+	cmdq_print(item, "Pane memory: %zu bytes", total);
+#ifdef ENABLE_SIXEL
+	cmdq_print(item, "Image memory: %zu bytes", image_memory(NULL));
+#endif
+
+	total = 0;
+	pb = NULL;
+	while ((pb = paste_walk(pb)) != NULL) {
+		paste_buffer_data(pb, &size);
+		total += size;
+		buffers++;
+	}
+	cmdq_print(item, "Paste buffers: %u, %zu bytes", buffers, total);
+}
+
+/* Print a histogram. */
+static void
+stats_print_histogram(struct cmdq_item *item, const char *name,
+    struct stats_histogram *sh)
+{
+	char	buf[512], tmp[64];
+	u_int	i;
+
+	if (sh->count == 0) {
+		cmdq_print(item, "%s: count=0", name);
+		return;
+	}
+
+	*buf = '\0';
+	for (i = 0; i < STATS_BUCKETS; i++) {
+		if (sh->buckets[i] == 0)
+			continue;
+		if (i == STATS_BUCKETS - 1) {
+			xsnprintf(tmp, sizeof tmp, " >=%lluus:%llu",
+			    1ULL << (i - 1), (unsigned long long)sh->buckets[i]);
+		} else {
+			xsnprintf(tmp, sizeof tmp, " <%lluus:%llu", 1ULL << i,
+			    (unsigned long long)sh->buckets[i]);
+		}
+		strlcat(buf, tmp, sizeof buf);
+	}
+	cmdq_print(item, "%s: count=%llu, average=%lluus, max=%lluus,%s", name,
+	    (unsigned long long)sh->count,
+	    (unsigned long long)(sh->total / sh->count),
+	    (unsigned long long)sh->max, buf);
+}
+
+/* Print all statistics. */
+void
+stats_print(struct cmdq_item *item)
+{
+	struct stats		*st = &global_stats;
+	struct client		*c;
+	struct window_pane	*wp;
+	struct stats_stall	*ss;
+	struct tm		*tm;
+	char			*name, tim[64];
+	u_int			 i;
+
+	cmdq_print(item, "Queue items: %llu", (unsigned long long)st->items);
+	cmdq_print(item, "Input: %llu bytes", (unsigned long long)st->input);
+	cmdq_print(item, "Cells written: %llu", (unsigned long long)st->cells);
+	cmdq_print(item, "Output: %llu bytes, %llu discarded",
+	    (unsigned long long)st->output, (unsigned long long)st->discarded);
+	cmdq_print(item, "Redraws: %llu, %llu full",
+	    (unsigned long long)st->redraws,
+	    (unsigned long long)st->full_redraws);
+
+	cmdq_print(item, "Stalls: %llu", (unsigned long long)st->stalls);
+
+	stats_print_histogram(item, "Input time", &st->input_time);
+	stats_print_histogram(item, "Redraw time", &st->redraw_time);
+	stats_print_histogram(item, "Format time", &st->format_time);
+	stats_print_histogram(item, "Echo time", &st->echo_time);
+	stats_print_histogram(item, "Echo input time", &st->echo_input_time);
+	stats_print_histogram(item, "Echo pane time", &st->echo_pane_time);
+	stats_print_histogram(item, "Echo output time", &st->echo_output_time);
+
+	TAILQ_FOREACH(c, &clients, entry) {
+		if (c->session == NULL)
+			continue;
+		cmdq_print(item, "Client %s: written=%zu, discarded=%zu, "
+		    "redraws=%llu, full=%llu", c->name, c->written,
+		    c->discarded, (unsigned long long)c->redraws,
+		    (unsigned long long)c->full_redraws);
+		xasprintf(&name, "Client %s echo time", c->name);
+		stats_print_histogram(item, name, &c->echo_time);
+		free(name);
+	}
+	RB_FOREACH(wp, window_pane_tree, &all_window_panes) {
+		cmdq_print(item, "Pane %%%u: input=%llu, cells=%llu", wp->id,
+		    (unsigned long long)wp->input_bytes,
+		    (unsigned long long)wp->cells_written);
+	}
+
+	for (i = 0; i < STATS_STALLS; i++) {
+		ss = &stats_stalls[(stats_stalls_next + i) % STATS_STALLS];
+		if (ss->text == NULL)
+			continue;
+		tm = localtime(&ss->time.tv_sec);
+		strftime(tim, sizeof tim, "%H:%M:%S", tm);
+		cmdq_print(item, "Stall at %s.%03d: %llums, %s", tim,
+		    (int)(ss->time.tv_usec / 1000),
+		    (unsigned long long)ss->duration / 1000, ss->text);
+	}
+}
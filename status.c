@@ -33,6 +33,131 @@ static void	 status_message_area(struct client *, u_int *, u_int *);
 static void	 status_message_callback(int, short, void *);
 static void	 status_timer_callback(int, short, void *);
 
+/*
+ * Rendered status line shared between clients. The output of format_draw
+ * depends only on the width, the base style and the expanded string (which
+ * already contains anything taken from the client), so clients with the same
+ * inputs can copy the same rendered line instead of drawing it again.
+ */
+struct status_cache_entry {
+	char				*expanded;
+	u_int				 width;
+	struct grid_cell		 style;
+
+	struct screen			 screen;
+	struct style_ranges		 ranges;
+
+	u_int				 references;
+	RB_ENTRY(status_cache_entry)	 entry;
+};
+RB_HEAD(status_cache_tree, status_cache_entry);
+static int	status_cache_cmp(struct status_cache_entry *,
+		    struct status_cache_entry *);
+RB_GENERATE_STATIC(status_cache_tree, status_cache_entry, entry,
+    status_cache_cmp);
+static struct status_cache_tree status_cache = RB_INITIALIZER(&status_cache);
+
+/* Compare status cache entries. */
+static int
+status_cache_cmp(struct status_cache_entry *sce1,
+    struct status_cache_entry *sce2)
+{
+	const struct grid_cell	*gc1 = &sce1->style, *gc2 = &sce2->style;
+
+	if (sce1->width != sce2->width)
+		return (sce1->width < sce2->width ? -1 : 1);
+	if (gc1->fg != gc2->fg)
+		return (gc1->fg < gc2->fg ? -1 : 1);
+	if (gc1->bg != gc2->bg)
+		return (gc1->bg < gc2->bg ? -1 : 1);
+	if (gc1->us != gc2->us)
+		return (gc1->us < gc2->us ? -1 : 1);
+	if (gc1->attr != gc2->attr)
+		return (gc1->attr < gc2->attr ? -1 : 1);
+	if (gc1->flags != gc2->flags)
+		return (gc1->flags < gc2->flags ? -1 : 1);
+	return (strcmp(sce1->expanded, sce2->expanded));
+}
+
+/*
+ * Find or render a shared status line. Lines with hyperlinks are not shared
+ * because the link numbers belong to the screen they were drawn into.
+ */
+static struct status_cache_entry *
+status_cache_get(u_int width, const struct grid_cell *gc, const char *expanded)
+{
+	struct status_cache_entry	 find, *sce;
+	struct screen_write_ctx		 ctx;
+	u_int				 n;
+
+	if (strcasestr(expanded, "link=") != NULL)
+		return (NULL);
+
+	find.width = width;
+	memcpy(&find.style, gc, sizeof find.style);
+	find.expanded = (char *)expanded;
+	sce = RB_FIND(status_cache_tree, &status_cache, &find);
+	if (sce != NULL) {
+		sce->references++;
+		log_debug("%s: hit %p (%u references)", __func__, sce,
+		    sce->references);
+		return (sce);
+	}
+
+	sce = xcalloc(1, sizeof *sce);
+	sce->expanded = xstrdup(expanded);
+	sce->width = width;
+	memcpy(&sce->style, gc, sizeof sce->style);
+	style_ranges_init(&sce->ranges);
+	sce->references = 1;
+
+	screen_init(&sce->screen, width, 1, 0);
+	screen_write_start(&ctx, &sce->screen);
+	for (n = 0; n < width; n++)
+		screen_write_putc(&ctx, gc, ' ');
+	screen_write_cursormove(&ctx, 0, 0, 0);
+	format_draw(&ctx, gc, width, expanded, &sce->ranges, 0);
+	screen_write_stop(&ctx);
+
+	RB_INSERT(status_cache_tree, &status_cache, sce);
+	log_debug("%s: miss %p", __func__, sce);
+	return (sce);
+}
+
+/* Release a shared status line. */
+static void
+status_cache_release(struct status_cache_entry *sce)
+{
+	if (sce == NULL || --sce->references != 0)
+		return;
+	RB_REMOVE(status_cache_tree, &status_cache, sce);
+	style_ranges_free(&sce->ranges);
+	screen_free(&sce->screen);
+	free(sce->expanded);
+	free(sce);
+}
+
+/* Copy a shared status line into a client status line. */
+static void
+status_cache_copy(struct status_line *sl, u_int line,
+    struct status_cache_entry *sce)
+{
+	struct style_line_entry	*sle = &sl->entries[line];
+	struct style_range	*sr, *new_sr;
+
+	grid_duplicate_lines(sl->screen.grid, line, sce->screen.grid, 0, 1);
+
+	style_ranges_free(&sle->ranges);
+	TAILQ_FOREACH(sr, &sce->ranges, entry) {
+		new_sr = xmalloc(sizeof *new_sr);
+		memcpy(new_sr, sr, sizeof *new_sr);
+		TAILQ_INSERT_TAIL(&sle->ranges, new_sr, entry);
+	}
+
+	status_cache_release(sl->cache[line]);
+	sl->cache[line] = sce;
+}
+
 /* Status timer callback. */
 static void
 status_timer_callback(__unused int fd, __unused short events, void *arg)
@@ -198,6 +323,8 @@ status_free(struct client *c)
 	for (i = 0; i < nitems(sl->entries); i++) {
 		style_ranges_free(&sl->entries[i].ranges);
 		free((void *)sl->entries[i].expanded);
+		status_cache_release(sl->cache[i]);
+		sl->cache[i] = NULL;
 	}
 
 	if (event_initialized(&sl->timer))
@@ -224,6 +351,7 @@ status_redraw(struct client *c)
 	struct options_entry		*o;
 	union options_value		*ov;
 	struct format_tree		*ft;
+	struct status_cache_entry	*sce;
 	char				*expanded;
 
 	log_debug("%s enter", __func__);
@@ -291,13 +419,21 @@ status_redraw(struct client *c)
 			}
 			changed = 1;
 
-			for (n = 0; n < width; n++)
-				screen_write_putc(&ctx, &gc, ' ');
-			screen_write_cursormove(&ctx, 0, i, 0);
+			sce = status_cache_get(width, &gc, expanded);
+			if (sce != NULL)
+				status_cache_copy(sl, i, sce);
+			else {
+				for (n = 0; n < width; n++)
+					screen_write_putc(&ctx, &gc, ' ');
+				screen_write_cursormove(&ctx, 0, i, 0);
 
-			style_ranges_free(&sle->ranges);
-			format_draw(&ctx, &gc, width, expanded, &sle->ranges,
-			    0);
+				style_ranges_free(&sle->ranges);
+				format_draw(&ctx, &gc, width, expanded,
+				    &sle->ranges, 0);
+
+				status_cache_release(sl->cache[i]);
+				sl->cache[i] = NULL;
+			}
 
 			free(sle->expanded);
 			sle->expanded = expanded;
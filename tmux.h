@@ -74,6 +74,7 @@ struct screen_write_citem;
 struct screen_write_cline;
 struct screen_write_ctx;
 struct session;
+struct status_cache_entry;
 
 #ifdef ENABLE_SIXEL
 struct sixel_image;
@@ -82,6 +83,7 @@ struct sixel_image;
 struct tty_ctx;
 struct tty_code;
 struct tty_key;
+struct tty_keys;
 struct tmuxpeer;
 struct tmuxproc;
 struct winlink;
@@ -114,6 +116,12 @@ struct winlink;
 #define WINDOW_MINIMUM PANE_MINIMUM
 #define WINDOW_MAXIMUM 10000
 
+/*
+ * Time a window size must be unchanged for before resizing a window whose size
+ * is changing quickly, in milliseconds. Must be < 1 second.
+ */
+#define WINDOW_RESIZE_DELAY 100
+
 /* Automatic name refresh interval, in microseconds. Must be < 1 second. */
 #define NAME_INTERVAL 500000
 
@@ -893,6 +901,8 @@ struct grid_line {
 struct grid {
 	int			 flags;
 #define GRID_HISTORY 0x1 /* scroll lines into history */
+#define GRID_LAZYREFLOW 0x2 /* reflow may be delayed */
+#define GRID_REFLOWTARGET 0x4 /* being reflowed into, add no UTF-8 */
 
 	u_int			 sx;
 	u_int			 sy;
@@ -905,7 +915,12 @@ struct grid {
 	u_int			 scroll_collected;
 	u_int			 scroll_generation;
 
+	u_int			 reflow_y;
+	u_int			 reflow_sx;
+
 	struct grid_line	*linedata;
+
+	TAILQ_ENTRY(grid)	 entry;
 };
 
 /* Virtual cursor in a grid. */
@@ -999,11 +1014,30 @@ struct style {
 
 #ifdef ENABLE_SIXEL
 /* Image. */
+struct image_output {
+	u_int			 xpixel;
+	u_int			 ypixel;
+	u_int			 ox;
+	u_int			 oy;
+	u_int			 sx;
+	u_int			 sy;
+
+	char			*data;
+	size_t			 size;
+
+	TAILQ_ENTRY (image_output) entry;
+};
+TAILQ_HEAD(image_outputs, image_output);
+
 struct image {
 	struct screen		*s;
 	struct sixel_image	*data;
 	char			*fallback;
 
+	struct image_outputs	 outputs;
+	u_int			 noutputs;
+	size_t			 size;
+
 	u_int			 px;
 	u_int			 py;
 	u_int			 sx;
@@ -1302,6 +1336,8 @@ struct window_pane {
 #define PANE_REDRAWSCROLLBAR 0x8000
 #define PANE_DESTROYED 0x10000
 #define PANE_CMDRUNNING 0x20000
+#define PANE_PROCSTALE 0x40000
+#define PANE_MEMORYLIMIT 0x80000
 
 	bitstr_t	*sync_dirty;
 	u_int		 sync_dirty_size;
@@ -1324,6 +1360,11 @@ struct window_pane {
 	struct cmdq_item *wait_item;	/* new-pane -W: waiting for pane exit */
 	struct spawn_editor_state *editor;
 
+	pid_t		 proc_pgrp;	/* cached foreground process group */
+	char		*proc_name;
+	char		*proc_cwd;
+	uint64_t	 proc_time;
+
 	time_t		 last_output_time;
 	time_t		 last_prompt_time;
 	time_t		 cmd_start_time;
@@ -1336,6 +1377,11 @@ struct window_pane {
 	struct window_pane_offset offset;
 	size_t		 base_offset;
 
+	uint64_t	 input_bytes;
+	uint64_t	 cells_written;
+	uint64_t	 memory_next;
+	size_t		 memory_buffered;
+
 	struct window_pane_resizes resize_queue;
 	struct event	 resize_timer;
 	struct event	 sync_timer;
@@ -1426,6 +1472,9 @@ struct window {
 	u_int			 new_sy;
 	u_int			 new_xpixel;
 	u_int			 new_ypixel;
+	struct event		 resize_timer;
+	uint64_t		 resize_changed;
+	uint64_t		 resize_previous;
 
 	uint64_t		 redraw_scene_generation;
 
@@ -1668,9 +1717,12 @@ struct key_event {
 
 	key_code		 key;
 	struct mouse_event	 m;
+	uint64_t		 time;	/* when read from terminal */
 
 	char			*buf;
 	size_t			 len;
+
+	struct key_event	*next;	/* batched after this key */
 };
 
 /* Terminal definition. */
@@ -1788,7 +1840,7 @@ struct tty {
 			    struct mouse_event *);
 
 	struct event	 key_timer;
-	struct tty_key	*key_tree;
+	struct tty_keys	*keys;
 };
 
 /* Terminal command context. */
@@ -2029,6 +2081,7 @@ struct status_line {
 
 	struct grid_cell	 style;
 	struct style_line_entry entries[STATUS_LINES_LIMIT];
+	struct status_cache_entry *cache[STATUS_LINES_LIMIT];
 };
 
 /* File in client. */
@@ -2162,6 +2215,57 @@ typedef int (*overlay_key_cb)(struct client *, void *, struct key_event *);
 typedef void (*overlay_free_cb)(struct client *, void *);
 typedef void (*overlay_resize_cb)(struct client *, void *);
 
+/* Statistics histogram, with a bucket for each power of two microseconds. */
+#define STATS_BUCKETS 24
+struct stats_histogram {
+	uint64_t	 count;
+	uint64_t	 total;
+	uint64_t	 max;
+	uint64_t	 buckets[STATS_BUCKETS];
+};
+
+/* Server statistics. */
+struct stats {
+	uint64_t		 items;
+	uint64_t		 stalls;
+	uint64_t		 input;
+	uint64_t		 cells;
+	uint64_t		 output;
+	uint64_t		 discarded;
+	uint64_t		 redraws;
+	uint64_t		 full_redraws;
+
+	struct stats_histogram	 input_time;
+	struct stats_histogram	 redraw_time;
+	struct stats_histogram	 format_time;
+
+	struct stats_histogram	 echo_time;
+	struct stats_histogram	 echo_input_time;
+	struct stats_histogram	 echo_pane_time;
+	struct stats_histogram	 echo_output_time;
+};
+
+/*
+ * Times for a key from a client being echoed: read from the terminal,
+ * written to the pane, first output read back from the pane.
+ */
+#define STATS_ECHO_TIMEOUT 1000000
+struct stats_echo {
+	u_int			 pane;
+	uint64_t		 key;
+	uint64_t		 written;
+	uint64_t		 read;
+};
+
+/* Something which blocked the server for longer than stall-threshold. */
+#define STATS_STALLS 100
+#define STATS_STALL_DEFAULT 100
+struct stats_stall {
+	struct timeval		 time;
+	uint64_t		 duration;
+	char			*text;
+};
+
 /* Client connection. */
 struct client {
 	const char		*name;
@@ -2204,6 +2308,10 @@ struct client {
 	size_t			 written;
 	size_t			 discarded;
 	size_t			 redraw;
+	uint64_t		 redraws;
+	uint64_t		 full_redraws;
+	struct stats_echo	 echo;
+	struct stats_histogram	 echo_time;
 
 	struct redraw_scene	*redraw_scene;
 
@@ -2291,6 +2399,7 @@ struct client {
 	struct key_table	*keytable;
 	key_code		 last_key;
 	time_t			 paste_time;
+	struct key_event	*key_batch;
 
 	int			 message_ignore_keys;
 	int			 message_ignore_styles;
@@ -2429,6 +2538,278 @@ enum options_table_type {
 #define OPTIONS_TABLE_IS_STYLE 0x4
 #define OPTIONS_TABLE_IS_COLOUR 0x8
 
+/* Option IDs, each the index of the option in options_table. */
+enum options_table_id {
+	OPTION_ALLOCATION_STATS,
+	OPTION_BACKSPACE,
+	OPTION_BUFFER_LIMIT,
+	OPTION_COMMAND_ALIAS,
+	OPTION_CODEPOINT_WIDTHS,
+	OPTION_COPY_COMMAND,
+	OPTION_CURSOR_COLOUR,
+	OPTION_CURSOR_STYLE,
+	OPTION_DEFAULT_CLIENT_COMMAND,
+	OPTION_DEFAULT_TERMINAL,
+	OPTION_EDITOR,
+	OPTION_ESCAPE_TIME,
+	OPTION_EXIT_EMPTY,
+	OPTION_EXIT_UNATTACHED,
+	OPTION_EXTENDED_KEYS,
+	OPTION_EXTENDED_KEYS_FORMAT,
+	OPTION_FOCUS_EVENTS,
+	OPTION_GET_CLIPBOARD,
+	OPTION_HISTORY_FILE,
+	OPTION_IMAGE_MEMORY_LIMIT,
+	OPTION_INPUT_BUFFER_SIZE,
+	OPTION_LOG_BUFFER_LINES,
+	OPTION_MENU_STYLE,
+	OPTION_MENU_SELECTED_STYLE,
+	OPTION_MENU_BORDER_STYLE,
+	OPTION_MENU_BORDER_LINES,
+	OPTION_MESSAGE_LIMIT,
+	OPTION_PREFIX_TIMEOUT,
+	OPTION_PROMPT_HISTORY_LIMIT,
+	OPTION_SET_CLIPBOARD,
+	OPTION_STALL_THRESHOLD,
+	OPTION_TERMINAL_OVERRIDES,
+	OPTION_TERMINAL_FEATURES,
+	OPTION_THEME,
+	OPTION_DARK_THEME_BLACK,
+	OPTION_DARK_THEME_WHITE,
+	OPTION_DARK_THEME_LIGHT_GREY,
+	OPTION_DARK_THEME_DARK_GREY,
+	OPTION_DARK_THEME_GREEN,
+	OPTION_DARK_THEME_YELLOW,
+	OPTION_DARK_THEME_RED,
+	OPTION_DARK_THEME_BLUE,
+	OPTION_DARK_THEME_CYAN,
+	OPTION_DARK_THEME_MAGENTA,
+	OPTION_LIGHT_THEME_BLACK,
+	OPTION_LIGHT_THEME_WHITE,
+	OPTION_LIGHT_THEME_LIGHT_GREY,
+	OPTION_LIGHT_THEME_DARK_GREY,
+	OPTION_LIGHT_THEME_GREEN,
+	OPTION_LIGHT_THEME_YELLOW,
+	OPTION_LIGHT_THEME_RED,
+	OPTION_LIGHT_THEME_BLUE,
+	OPTION_LIGHT_THEME_CYAN,
+	OPTION_LIGHT_THEME_MAGENTA,
+	OPTION_USER_KEYS,
+	OPTION_VARIATION_SELECTOR_ALWAYS_WIDE,
+	OPTION_ACTIVITY_ACTION,
+	OPTION_ASSUME_PASTE_TIME,
+	OPTION_BASE_INDEX,
+	OPTION_BELL_ACTION,
+	OPTION_DEFAULT_COMMAND,
+	OPTION_DEFAULT_SHELL,
+	OPTION_DEFAULT_SIZE,
+	OPTION_DESTROY_UNATTACHED,
+	OPTION_DETACH_ON_DESTROY,
+	OPTION_DISPLAY_PANES_ACTIVE_COLOUR,
+	OPTION_DISPLAY_PANES_COLOUR,
+	OPTION_DISPLAY_PANES_FORMAT,
+	OPTION_DISPLAY_PANES_TIME,
+	OPTION_DISPLAY_TIME,
+	OPTION_FOCUS_FOLLOWS_MOUSE,
+	OPTION_HISTORY_LIMIT,
+	OPTION_INITIAL_REPEAT_TIME,
+	OPTION_KEY_TABLE,
+	OPTION_LOCK_AFTER_TIME,
+	OPTION_LOCK_COMMAND,
+	OPTION_MESSAGE_COMMAND_STYLE,
+	OPTION_MESSAGE_FORMAT,
+	OPTION_MESSAGE_LINE,
+	OPTION_MESSAGE_STYLE,
+	OPTION_MOUSE,
+	OPTION_MOUSE_COALESCE,
+	OPTION_PREFIX,
+	OPTION_PREFIX2,
+	OPTION_RENUMBER_WINDOWS,
+	OPTION_REPEAT_TIME,
+	OPTION_SET_TITLES,
+	OPTION_SET_TITLES_STRING,
+	OPTION_SILENCE_ACTION,
+	OPTION_STATUS,
+	OPTION_STATUS_BG,
+	OPTION_STATUS_FG,
+	OPTION_STATUS_FORMAT,
+	OPTION_STATUS_INTERVAL,
+	OPTION_STATUS_JUSTIFY,
+	OPTION_STATUS_KEYS,
+	OPTION_STATUS_LEFT,
+	OPTION_STATUS_LEFT_LENGTH,
+	OPTION_STATUS_LEFT_STYLE,
+	OPTION_STATUS_POSITION,
+	OPTION_STATUS_RIGHT,
+	OPTION_STATUS_RIGHT_LENGTH,
+	OPTION_STATUS_RIGHT_STYLE,
+	OPTION_STATUS_STYLE,
+	OPTION_PANE_STATUS_CURRENT_STYLE,
+	OPTION_PANE_STATUS_STYLE,
+	OPTION_PROMPT_CURSOR_COLOUR,
+	OPTION_PROMPT_COMMAND_CURSOR_COLOUR,
+	OPTION_PROMPT_CURSOR_STYLE,
+	OPTION_PROMPT_COMMAND_CURSOR_STYLE,
+	OPTION_SESSION_STATUS_CURRENT_STYLE,
+	OPTION_SESSION_STATUS_STYLE,
+	OPTION_UPDATE_ENVIRONMENT,
+	OPTION_VISUAL_ACTIVITY,
+	OPTION_VISUAL_BELL,
+	OPTION_VISUAL_SILENCE,
+	OPTION_WORD_SEPARATORS,
+	OPTION_AGGRESSIVE_RESIZE,
+	OPTION_ALLOW_PASSTHROUGH,
+	OPTION_ALLOW_RENAME,
+	OPTION_ALLOW_SET_TITLE,
+	OPTION_ALTERNATE_SCREEN,
+	OPTION_AUTOMATIC_RENAME,
+	OPTION_AUTOMATIC_RENAME_FORMAT,
+	OPTION_CLOCK_MODE_COLOUR,
+	OPTION_CLOCK_MODE_STYLE,
+	OPTION_COPY_MODE_MATCH_STYLE,
+	OPTION_COPY_MODE_CURRENT_MATCH_STYLE,
+	OPTION_COPY_MODE_MARK_STYLE,
+	OPTION_COPY_MODE_POSITION_FORMAT,
+	OPTION_COPY_MODE_POSITION_STYLE,
+	OPTION_COPY_MODE_SELECTION_STYLE,
+	OPTION_COPY_MODE_CURRENT_LINE_NUMBER_STYLE,
+	OPTION_COPY_MODE_LINE_NUMBER_STYLE,
+	OPTION_COPY_MODE_LINE_NUMBERS,
+	OPTION_FILL_CHARACTER,
+	OPTION_MAIN_PANE_HEIGHT,
+	OPTION_MAIN_PANE_WIDTH,
+	OPTION_MODE_KEYS,
+	OPTION_MODE_STYLE,
+	OPTION_MONITOR_ACTIVITY,
+	OPTION_MONITOR_BELL,
+	OPTION_MONITOR_SILENCE,
+	OPTION_OTHER_PANE_HEIGHT,
+	OPTION_OTHER_PANE_WIDTH,
+	OPTION_PANE_ACTIVE_BORDER_STYLE,
+	OPTION_PANE_BASE_INDEX,
+	OPTION_PANE_BORDER_FORMAT,
+	OPTION_PANE_BORDER_INDICATORS,
+	OPTION_PANE_BORDER_LINES,
+	OPTION_PANE_BORDER_STATUS,
+	OPTION_PANE_BORDER_STYLE,
+	OPTION_PANE_COLOURS,
+	OPTION_PANE_MEMORY_LIMIT,
+	OPTION_PANE_SCROLLBARS,
+	OPTION_PANE_SCROLLBARS_TIMEOUT,
+	OPTION_PANE_SCROLLBARS_STYLE,
+	OPTION_PANE_SCROLLBARS_POSITION,
+	OPTION_POPUP_STYLE,
+	OPTION_POPUP_BORDER_STYLE,
+	OPTION_POPUP_BORDER_LINES,
+	OPTION_REMAIN_ON_EXIT,
+	OPTION_REMAIN_ON_EXIT_FORMAT,
+	OPTION_SCROLL_ON_CLEAR,
+	OPTION_SWITCH_MODE_MATCH_STYLE,
+	OPTION_SYNCHRONIZE_PANES,
+	OPTION_TILED_LAYOUT_MAX_COLUMNS,
+	OPTION_TREE_MODE_BORDER_STYLE,
+	OPTION_TREE_MODE_PREVIEW_FORMAT,
+	OPTION_TREE_MODE_PREVIEW_STYLE,
+	OPTION_TREE_MODE_SELECTION_STYLE,
+	OPTION_WINDOW_ACTIVE_STYLE,
+	OPTION_WINDOW_PANE_CURRENT_STATUS_FORMAT,
+	OPTION_WINDOW_PANE_STATUS_FORMAT,
+	OPTION_WINDOW_SIZE,
+	OPTION_WINDOW_STYLE,
+	OPTION_WINDOW_STATUS_ACTIVITY_STYLE,
+	OPTION_WINDOW_STATUS_BELL_STYLE,
+	OPTION_WINDOW_STATUS_CURRENT_FORMAT,
+	OPTION_WINDOW_STATUS_CURRENT_STYLE,
+	OPTION_WINDOW_STATUS_FORMAT,
+	OPTION_WINDOW_STATUS_LAST_STYLE,
+	OPTION_WINDOW_STATUS_SEPARATOR,
+	OPTION_WINDOW_STATUS_STYLE,
+	OPTION_WRAP_SEARCH,
+	OPTION_XTERM_KEYS,
+	OPTION_AFTER_BIND_KEY,
+	OPTION_AFTER_CAPTURE_PANE,
+	OPTION_AFTER_COPY_MODE,
+	OPTION_AFTER_DISPLAY_MESSAGE,
+	OPTION_AFTER_DISPLAY_PANES,
+	OPTION_AFTER_KILL_PANE,
+	OPTION_AFTER_LIST_BUFFERS,
+	OPTION_AFTER_LIST_CLIENTS,
+	OPTION_AFTER_LIST_KEYS,
+	OPTION_AFTER_LIST_PANES,
+	OPTION_AFTER_LIST_SESSIONS,
+	OPTION_AFTER_LIST_WINDOWS,
+	OPTION_AFTER_LOAD_BUFFER,
+	OPTION_AFTER_LOCK_SERVER,
+	OPTION_AFTER_NEW_SESSION,
+	OPTION_AFTER_NEW_WINDOW,
+	OPTION_AFTER_PASTE_BUFFER,
+	OPTION_AFTER_PIPE_PANE,
+	OPTION_AFTER_QUEUE,
+	OPTION_AFTER_REFRESH_CLIENT,
+	OPTION_AFTER_RENAME_SESSION,
+	OPTION_AFTER_RENAME_WINDOW,
+	OPTION_AFTER_RESIZE_PANE,
+	OPTION_AFTER_RESIZE_WINDOW,
+	OPTION_AFTER_SAVE_BUFFER,
+	OPTION_AFTER_SELECT_LAYOUT,
+	OPTION_AFTER_SELECT_PANE,
+	OPTION_AFTER_SELECT_WINDOW,
+	OPTION_AFTER_SEND_KEYS,
+	OPTION_AFTER_SET_BUFFER,
+	OPTION_AFTER_SET_ENVIRONMENT,
+	OPTION_AFTER_SET_HOOK,
+	OPTION_AFTER_SET_OPTION,
+	OPTION_AFTER_SHOW_ENVIRONMENT,
+	OPTION_AFTER_SHOW_MESSAGES,
+	OPTION_AFTER_SHOW_OPTIONS,
+	OPTION_AFTER_SPLIT_WINDOW,
+	OPTION_AFTER_UNBIND_KEY,
+	OPTION_ALERT_ACTIVITY,
+	OPTION_ALERT_BELL,
+	OPTION_ALERT_SILENCE,
+	OPTION_CLIENT_ACTIVE,
+	OPTION_CLIENT_ATTACHED,
+	OPTION_CLIENT_DETACHED,
+	OPTION_CLIENT_FOCUS_IN,
+	OPTION_CLIENT_FOCUS_OUT,
+	OPTION_CLIENT_RESIZED,
+	OPTION_CLIENT_SESSION_CHANGED,
+	OPTION_CLIENT_LIGHT_THEME,
+	OPTION_CLIENT_DARK_THEME,
+	OPTION_COMMAND_ERROR,
+	OPTION_MARKED_PANE_CHANGED,
+	OPTION_PANE_COMMAND_FINISHED,
+	OPTION_PANE_COMMAND_STARTED,
+	OPTION_PANE_CREATED,
+	OPTION_PANE_DIED,
+	OPTION_PANE_EXITED,
+	OPTION_PANE_FOCUS_IN,
+	OPTION_PANE_FOCUS_OUT,
+	OPTION_PANE_MODE_CHANGED,
+	OPTION_PANE_MODE_ENTERED,
+	OPTION_PANE_MODE_EXITED,
+	OPTION_PANE_PROMPT_CLOSED,
+	OPTION_PANE_PROMPT_OPENED,
+	OPTION_PANE_RESIZED,
+	OPTION_PANE_SET_CLIPBOARD,
+	OPTION_PANE_SHELL_PROMPT,
+	OPTION_PANE_TITLE_CHANGED,
+	OPTION_SESSION_CLOSED,
+	OPTION_SESSION_CREATED,
+	OPTION_SESSION_RENAMED,
+	OPTION_SESSION_WINDOW_CHANGED,
+	OPTION_WINDOW_LAYOUT_CHANGED,
+	OPTION_WINDOW_LINKED,
+	OPTION_WINDOW_PANE_CHANGED,
+	OPTION_WINDOW_RENAMED,
+	OPTION_WINDOW_RESIZED,
+	OPTION_WINDOW_UNZOOMED,
+	OPTION_WINDOW_ZOOMED,
+	OPTION_WINDOW_UNLINKED,
+
+	OPTION_COUNT
+};
+
 struct options_table_entry {
 	const char		 *name;
 	const char		 *alternative_name;
@@ -2436,8 +2817,8 @@ struct options_table_entry {
 	int			  scope;
 	int			  flags;
 
-	u_int			  minimum;
-	u_int			  maximum;
+	long long		  minimum;
+	long long		  maximum;
 	const char		**choices;
 
 	const char		 *default_str;
@@ -2558,6 +2939,8 @@ struct imsg;
 int	proc_send(struct tmuxpeer *, enum msgtype, int, const void *, size_t);
 struct tmuxproc *proc_start(const char *);
 void	proc_loop(struct tmuxproc *, int (*)(void));
+struct bufferevent *proc_bufferevent_new(int, bufferevent_data_cb,
+	    bufferevent_data_cb, bufferevent_event_cb, void *);
 void	proc_exit(struct tmuxproc *);
 void	proc_set_signals(struct tmuxproc *, void(*)(int));
 void	proc_clear_signals(struct tmuxproc *, int);
@@ -2675,6 +3058,7 @@ void		 format_defaults_pane(struct format_tree *,
 void		 format_defaults_paste_buffer(struct format_tree *,
 		     struct paste_buffer *);
 void		 format_lost_client(struct client *);
+void		 format_job_print_summary(struct cmdq_item *, int);
 char		*format_grid_word(struct grid *, u_int, u_int);
 char		*format_grid_hyperlink(struct grid *, u_int, u_int,
 		     struct screen *);
@@ -2772,6 +3156,7 @@ void		 options_set_monitor_data(struct options_entry *, void *);
 const struct options_table_entry *options_table_entry(struct options_entry *);
 struct options_entry *options_get_only(struct options *, const char *);
 struct options_entry *options_get(struct options *, const char *);
+struct options_entry *options_get_id(struct options *, enum options_table_id);
 void		 options_array_clear(struct options_entry *);
 union options_value *options_array_get(struct options_entry *, const char *);
 union options_value * printflike(2, 3) options_array_getv(
@@ -2796,6 +3181,10 @@ struct options_entry *options_match_get(struct options *, const char *,
 		     char **, int, int *);
 const char	*options_get_string(struct options *, const char *);
 long long	 options_get_number(struct options *, const char *);
+const char	*options_get_string_id(struct options *,
+	    enum options_table_id);
+long long	 options_get_number_id(struct options *,
+	    enum options_table_id);
 struct cmd_list *options_get_command(struct options *, const char *);
 struct options_entry * printflike(4, 5) options_set_string(struct options *,
 		     const char *, int, const char *, ...);
@@ -3273,6 +3662,8 @@ void	 server_client_set_key_table(struct client *, const char *);
 const char *server_client_get_key_table(struct client *);
 int	 server_client_check_nested(struct client *);
 int	 server_client_handle_key(struct client *, struct key_event *);
+int	 server_client_can_bulk_paste(struct client *);
+int	 server_client_can_coalesce_mouse(struct client *);
 int	 server_client_handle_key_after(struct client *, struct key_event *,
 	     struct cmdq_item *, struct cmdq_item **);
 struct client *server_client_create(int);
@@ -3441,12 +3832,16 @@ int	 grid_cells_look_equal(const struct grid_cell *,
 	     const struct grid_cell *);
 struct grid *grid_create(u_int, u_int, u_int);
 void	 grid_destroy(struct grid *);
+size_t	 grid_memory(struct grid *);
 void	 grid_free_lines(struct grid *, u_int, u_int);
+void	 grid_mark_utf8(void);
 int	 grid_compare(struct grid *, struct grid *);
 const char *grid_line_flags_string(int);
 const char *grid_cell_flags_string(int);
 const char *grid_cell_attr_string(int);
 void	 grid_collect_history(struct grid *, int);
+void	 grid_free_history(struct grid *, u_int);
+u_int	 grid_free_history_memory(struct grid *, size_t);
 void	 grid_remove_history(struct grid *, u_int );
 void	 grid_scroll_history(struct grid *, u_int);
 void	 grid_scroll_history_region(struct grid *, u_int, u_int, u_int);
@@ -3468,6 +3863,7 @@ char	*grid_string_cells(struct grid *, u_int, u_int, u_int,
 void	 grid_duplicate_lines(struct grid *, u_int, struct grid *, u_int,
 	     u_int);
 void	 grid_reflow(struct grid *, u_int);
+void	 grid_reflow_finish(struct grid *);
 void	 grid_wrap_position(struct grid *, u_int, u_int, u_int *, u_int *);
 void	 grid_unwrap_position(struct grid *, u_int *, u_int *, u_int, u_int);
 u_int	 grid_line_length(struct grid *, u_int);
@@ -3622,6 +4018,8 @@ void	 screen_pop_title(struct screen *);
 void	 screen_set_progress_bar(struct screen *, enum progress_bar_state, int);
 void	 screen_resize(struct screen *, u_int, u_int, int);
 void	 screen_resize_cursor(struct screen *, u_int, u_int, int, int, int);
+void	 screen_reflow_start(void);
+void	 screen_reflow_end(void);
 void	 screen_set_selection(struct screen *, u_int, u_int, u_int, u_int,
 	     u_int, u_int, int, struct grid_cell *);
 void	 screen_clear_selection(struct screen *);
@@ -3725,6 +4123,8 @@ u_int		 window_pane_search(struct window_pane *, const char *, int,
 		     int);
 const char	*window_printable_flags(struct winlink *, int);
 const char      *window_pane_printable_flags(struct window_pane *);
+const char	*window_pane_current_command(struct window_pane *);
+const char	*window_pane_current_path(struct window_pane *);
 struct window_pane *window_pane_find_up(struct window_pane *);
 struct window_pane *window_pane_find_down(struct window_pane *);
 struct window_pane *window_pane_find_left(struct window_pane *);
@@ -3746,6 +4146,9 @@ void		*window_pane_get_new_data(struct window_pane *,
 		     struct window_pane_offset *, size_t *);
 void		 window_pane_update_used_data(struct window_pane *,
 		     struct window_pane_offset *, size_t);
+size_t		 window_pane_memory(struct window_pane *);
+int		 window_pane_check_memory(struct window_pane *);
+int		 window_pane_check_memory_stopped(struct window_pane *);
 void		 window_set_fill_character(struct window *);
 void		 window_pane_default_cursor(struct window_pane *);
 int		 window_pane_mode(struct window_pane *);
@@ -4034,6 +4437,9 @@ enum utf8_state	 utf8_fromwc(wchar_t wc, struct utf8_data *);
 void		 utf8_update_width_cache(void);
 utf8_char	 utf8_build_one(u_char);
 enum utf8_state	 utf8_from_data(const struct utf8_data *, utf8_char *);
+enum utf8_state	 utf8_from_grid_data(const struct utf8_data *, utf8_char *);
+void		 utf8_find_grid_data(const struct utf8_data *, utf8_char *);
+void		 utf8_mark(utf8_char);
 void		 utf8_to_data(utf8_char, struct utf8_data *);
 void		 utf8_set(struct utf8_data *, u_char);
 void		 utf8_copy(struct utf8_data *, const struct utf8_data *);
@@ -4048,6 +4454,7 @@ size_t		 utf8_strlen(const struct utf8_data *);
 u_int		 utf8_strwidth(const struct utf8_data *, ssize_t);
 struct utf8_data *utf8_fromcstr(const char *);
 char		*utf8_tocstr(struct utf8_data *);
+size_t		 utf8_ascii_span(const char *, size_t, u_char);
 u_int		 utf8_cstrwidth(const char *);
 char		*utf8_padcstr(const char *, u_int);
 char		*utf8_rpadcstr(const char *, u_int);
@@ -4074,6 +4481,8 @@ int	log_get_level(void);
 void	log_open(const char *);
 void	log_toggle(const char *);
 void	log_close(void);
+void	log_set_buffer(u_int);
+void	log_print_buffer(struct cmdq_item *, int);
 void printflike(1, 2) log_debug(const char *, ...);
 __dead void printflike(1, 2) fatal(const char *, ...);
 __dead void printflike(1, 2) fatalx(const char *, ...);
@@ -4119,6 +4528,23 @@ int		 popup_present(struct client *);
 int		 popup_modify(struct client *, const char *, const char *,
 		    const char *, enum box_lines, int);
 
+/* stats.c */
+extern struct stats global_stats;
+uint64_t	 stats_time(void);
+void		 stats_add(struct stats_histogram *, uint64_t);
+void		 stats_add_time(struct stats_histogram *, uint64_t);
+void		 stats_echo_key(struct client *, struct window_pane *,
+		     uint64_t);
+void		 stats_echo_read(struct window_pane *);
+void		 stats_echo_cancel(struct client *);
+void		 stats_echo_flush(struct client *);
+void		 stats_set_stall_threshold(u_int);
+void		 stats_stall(uint64_t, const char *, const char *,
+		     struct client *, int);
+void		 stats_set_allocations(int);
+void		 stats_print(struct cmdq_item *);
+void		 stats_print_memory(struct cmdq_item *);
+
 /* style.c */
 int		 style_parse(struct style *,const struct grid_cell *,
 		     const char *);
@@ -4154,16 +4580,26 @@ char		*regsub(const char *, const char *, const char *, int);
 #ifdef ENABLE_SIXEL
 /* image.c */
 int		 image_free_all(struct screen *);
+int		 image_free_saved(struct screen *);
+size_t		 image_memory(struct screen *);
 struct image	*image_store(struct screen *, struct sixel_image *);
 int		 image_check_line(struct screen *, u_int, u_int);
 int		 image_check_area(struct screen *, u_int, u_int, u_int, u_int);
 int		 image_scroll_up(struct screen *, u_int);
+void		 image_used(struct image *);
+const char	*image_print(struct image *, u_int, u_int, u_int, u_int, u_int,
+		     u_int, size_t *);
 
 /* image-sixel.c */
 #define SIXEL_COLOUR_REGISTERS 1024
 struct sixel_image *sixel_parse(const char *, size_t, u_int, u_int, u_int);
+struct sixel_image *sixel_parse_start(u_int, u_int, u_int);
+int		 sixel_parse_data(struct sixel_image *, const char *, size_t,
+		     size_t *);
+struct sixel_image *sixel_parse_end(struct sixel_image *, const char *, size_t);
 void		 sixel_free(struct sixel_image *);
 void		 sixel_log(struct sixel_image *);
+size_t		 sixel_size_in_bytes(struct sixel_image *);
 void		 sixel_size_in_cells(struct sixel_image *, u_int *, u_int *);
 struct sixel_image *sixel_scale(struct sixel_image *, u_int, u_int, u_int,
 		     u_int, u_int, u_int, int);
@@ -4190,6 +4626,7 @@ u_int	 		 hyperlinks_put(struct hyperlinks *, const char *,
 int			 hyperlinks_get(struct hyperlinks *, u_int,
 			     const char **, const char **, const char **);
 struct hyperlinks	*hyperlinks_init(void);
+size_t			 hyperlinks_memory(struct hyperlinks *);
 struct hyperlinks	*hyperlinks_copy(struct hyperlinks *);
 void			 hyperlinks_reset(struct hyperlinks *);
 void			 hyperlinks_free(struct hyperlinks *);
@@ -34,15 +34,18 @@
 /*
  * Handle keys input from the outside terminal. tty_default_*_keys[] are a base
  * table of supported keys which are looked up in terminfo(5) and translated
- * into a ternary tree.
+ * into a ternary tree. The tree is then flattened into a table of states with
+ * one transition per input character, so looking up a key is a single array
+ * index for each byte.
  */
 
 static void	tty_keys_add1(struct tty_key **, const char *, key_code);
-static void	tty_keys_add(struct tty *, const char *, key_code);
+static void	tty_keys_add(struct tty_key **, const char *, key_code);
+static struct tty_key *tty_keys_find1(struct tty_key *, const char *);
 static void	tty_keys_free1(struct tty_key *);
-static struct tty_key *tty_keys_find1(struct tty_key *, const char *, size_t,
-		    size_t *);
-static struct tty_key *tty_keys_find(struct tty *, const char *, size_t,
+static u_int	tty_keys_compile(struct tty_keys *, struct tty_key *,
+		    key_code);
+static struct tty_key_state *tty_keys_find(struct tty *, const char *, size_t,
 		    size_t *);
 static int	tty_keys_next1(struct tty *, const char *, size_t, key_code *,
 		    size_t *, int);
@@ -51,6 +54,8 @@ static int	tty_keys_extended_key(struct tty *, const char *, size_t,
 		    size_t *, key_code *);
 static int	tty_keys_mouse(struct tty *, const char *, size_t, size_t *,
 		    struct mouse_event *);
+static int	tty_keys_mouse_coalesce(struct tty *, const char *, size_t,
+		    size_t, struct mouse_event *);
 static int	tty_keys_clipboard(struct tty *, const char *, size_t,
 		    size_t *);
 static int	tty_keys_device_attributes(struct tty *, const char *, size_t,
@@ -61,7 +66,7 @@ static int	tty_keys_extended_device_attributes(struct tty *, const char *,
 		    size_t, size_t *);
 static int	tty_keys_palette(struct tty *, const char *, size_t, size_t *);
 
-/* A key tree entry. */
+/* A key tree entry, only used while building the key table. */
 struct tty_key {
 	char		 ch;
 	key_code	 key;
@@ -72,6 +77,26 @@ struct tty_key {
 	struct tty_key	*next;
 };
 
+/* A key table state. */
+struct tty_key_state {
+	key_code	 key;
+
+	u_int		 first;
+	u_int		 count;
+	u_int		 base;
+};
+
+/* A key table. */
+struct tty_keys {
+	struct tty_key_state	*states;
+	u_int			 nstates;
+	u_int			 statesize;
+
+	u_int			*next;
+	u_int			 nnext;
+	u_int			 nextsize;
+};
+
 /* Default raw keys. */
 struct tty_default_key_raw {
 	const char	       *string;
@@ -431,16 +456,15 @@ static const struct tty_default_key_code tty_default_code_keys[] = {
 
 /* Add key to tree. */
 static void
-tty_keys_add(struct tty *tty, const char *s, key_code key)
+tty_keys_add(struct tty_key **tree, const char *s, key_code key)
 {
 	struct tty_key	*tk;
-	size_t		 size;
 	const char	*keystr;
 
 	keystr = key_string_lookup_key(key, 1);
-	if ((tk = tty_keys_find(tty, s, strlen(s), &size)) == NULL) {
+	if ((tk = tty_keys_find1(*tree, s)) == NULL) {
 		log_debug("new key %s: 0x%llx (%s)", s, key, keystr);
-		tty_keys_add1(&tty->key_tree, s, key);
+		tty_keys_add1(tree, s, key);
 	} else {
 		log_debug("replacing key %s: 0x%llx (%s)", s, key, keystr);
 		tk->key = key;
@@ -485,7 +509,117 @@ tty_keys_add1(struct tty_key **tkp, const char *s, key_code key)
 	tty_keys_add1(tkp, s, key);
 }
 
-/* Initialise a key tree from the table. */
+/*
+ * Find the node for a string in the tree. As when matching input, stop early
+ * if a complete key with nothing following it is a prefix of the string, so
+ * adding the longer string replaces that key.
+ */
+static struct tty_key *
+tty_keys_find1(struct tty_key *tk, const char *s)
+{
+	while (tk != NULL) {
+		if (*s == tk->ch) {
+			if (*++s == '\0' ||
+			    (tk->next == NULL && tk->key != KEYC_UNKNOWN))
+				return (tk);
+			tk = tk->next;
+		} else if (*s < tk->ch)
+			tk = tk->left;
+		else
+			tk = tk->right;
+	}
+	return (NULL);
+}
+
+/* Free a tree. */
+static void
+tty_keys_free1(struct tty_key *tk)
+{
+	if (tk->next != NULL)
+		tty_keys_free1(tk->next);
+	if (tk->left != NULL)
+		tty_keys_free1(tk->left);
+	if (tk->right != NULL)
+		tty_keys_free1(tk->right);
+	free(tk);
+}
+
+/* Get the range of characters used by the nodes at one level of the tree. */
+static void
+tty_keys_range(struct tty_key *tk, u_int *first, u_int *last)
+{
+	if (tk == NULL)
+		return;
+	if ((u_char)tk->ch < *first)
+		*first = (u_char)tk->ch;
+	if ((u_char)tk->ch > *last)
+		*last = (u_char)tk->ch;
+	tty_keys_range(tk->left, first, last);
+	tty_keys_range(tk->right, first, last);
+}
+
+/* Fill in the transitions for the nodes at one level of the tree. */
+static void
+tty_keys_compile1(struct tty_keys *tks, struct tty_key *tk, u_int base,
+    u_int first)
+{
+	u_int	state;
+
+	if (tk == NULL)
+		return;
+	state = tty_keys_compile(tks, tk->next, tk->key);
+	tks->next[base + (u_char)tk->ch - first] = state;
+	tty_keys_compile1(tks, tk->left, base, first);
+	tty_keys_compile1(tks, tk->right, base, first);
+}
+
+/*
+ * Add a state for a node with the given key and children and return its
+ * index. Each state has a transition for every character between the first
+ * and last used by its children; a transition of zero means no match (state
+ * zero is the start and cannot be reached again).
+ */
+static u_int
+tty_keys_compile(struct tty_keys *tks, struct tty_key *tk, key_code key)
+{
+	struct tty_key_state	*tks_state;
+	u_int			 state, first = UCHAR_MAX, last = 0, count;
+	u_int			 base;
+
+	if (tks->nstates == tks->statesize) {
+		tks->statesize = tks->statesize * 2 + 64;
+		tks->states = xreallocarray(tks->states, tks->statesize,
+		    sizeof *tks->states);
+	}
+	state = tks->nstates++;
+
+	tty_keys_range(tk, &first, &last);
+	if (tk == NULL)
+		count = 0;
+	else
+		count = last - first + 1;
+
+	base = tks->nnext;
+	if (tks->nnext + count > tks->nextsize) {
+		while (tks->nnext + count > tks->nextsize)
+			tks->nextsize = tks->nextsize * 2 + 256;
+		tks->next = xreallocarray(tks->next, tks->nextsize,
+		    sizeof *tks->next);
+	}
+	memset(tks->next + base, 0, count * sizeof *tks->next);
+	tks->nnext += count;
+
+	tks_state = &tks->states[state];
+	tks_state->key = key;
+	tks_state->first = first;
+	tks_state->count = count;
+	tks_state->base = base;
+
+	tty_keys_compile1(tks, tk, base, first);
+	return (state);
+}
+
+/* Initialise the key table from the default keys and terminfo. */
 void
 tty_keys_build(struct tty *tty)
 {
@@ -498,10 +632,10 @@ tty_keys_build(struct tty *tty)
 	union options_value			*ov;
 	char					 copy[16];
 	key_code				 key;
+	struct tty_key				*tree = NULL;
+	struct tty_keys				*tks;
 
-	if (tty->key_tree != NULL)
-		tty_keys_free(tty);
-	tty->key_tree = NULL;
+	tty_keys_free(tty);
 
 	for (i = 0; i < nitems(tty_default_xterm_keys); i++) {
 		tdkx = &tty_default_xterm_keys[i];
@@ -510,7 +644,7 @@ tty_keys_build(struct tty *tty)
 			copy[strcspn(copy, "_")] = '0' + j;
 
 			key = tdkx->key|tty_default_xterm_modifiers[j];
-			tty_keys_add(tty, copy, key);
+			tty_keys_add(&tree, copy, key);
 		}
 	}
 	for (i = 0; i < nitems(tty_default_raw_keys); i++) {
@@ -518,14 +652,14 @@ tty_keys_build(struct tty *tty)
 
 		s = tdkr->string;
 		if (*s != '\0')
-			tty_keys_add(tty, s, tdkr->key);
+			tty_keys_add(&tree, s, tdkr->key);
 	}
 	for (i = 0; i < nitems(tty_default_code_keys); i++) {
 		tdkc = &tty_default_code_keys[i];
 
 		s = tty_term_string(tty->term, tdkc->code);
 		if (*s != '\0')
-			tty_keys_add(tty, s, tdkc->key);
+			tty_keys_add(&tree, s, tdkc->key);
 
 	}
 
@@ -534,72 +668,59 @@ tty_keys_build(struct tty *tty)
 		for (i = 0; i <= KEYC_NUSER; i++) {
 			ov = options_array_getv(o, "%u", i);
 			if (ov != NULL)
-				tty_keys_add(tty, ov->string, KEYC_USER + i);
+				tty_keys_add(&tree, ov->string, KEYC_USER + i);
 		}
 	}
+
+	/* Flatten the tree into the transition table. */
+	tks = tty->keys = xcalloc(1, sizeof *tty->keys);
+	tty_keys_compile(tks, tree, KEYC_UNKNOWN);
+	log_debug("%s: %u key states, %u transitions", __func__, tks->nstates,
+	    tks->nnext);
+	if (tree != NULL)
+		tty_keys_free1(tree);
 }
 
-/* Free the entire key tree. */
+/* Free the key table. */
 void
 tty_keys_free(struct tty *tty)
 {
-	tty_keys_free1(tty->key_tree);
+	if (tty->keys == NULL)
+		return;
+	free(tty->keys->states);
+	free(tty->keys->next);
+	free(tty->keys);
+	tty->keys = NULL;
 }
 
-/* Free a single key. */
-static void
-tty_keys_free1(struct tty_key *tk)
-{
-	if (tk->next != NULL)
-		tty_keys_free1(tk->next);
-	if (tk->left != NULL)
-		tty_keys_free1(tk->left);
-	if (tk->right != NULL)
-		tty_keys_free1(tk->right);
-	free(tk);
-}
-
-/* Lookup a key in the tree. */
-static struct tty_key *
+/*
+ * Look up a key in the table. Returns the state reached either at the end of
+ * the buffer or when a key with no longer sequences is matched.
+ */
+static struct tty_key_state *
 tty_keys_find(struct tty *tty, const char *buf, size_t len, size_t *size)
 {
-	*size = 0;
-	return (tty_keys_find1(tty->key_tree, buf, len, size));
-}
-
-/* Find the next node. */
-static struct tty_key *
-tty_keys_find1(struct tty_key *tk, const char *buf, size_t len, size_t *size)
-{
-	/* If no data, no match. */
-	if (len == 0)
-		return (NULL);
-
-	/* If the node is NULL, this is the end of the tree. No match. */
-	if (tk == NULL)
-		return (NULL);
+	struct tty_keys		*tks = tty->keys;
+	struct tty_key_state	*tks_state = &tks->states[0];
+	u_int			 ch, state;
+
+	for (*size = 0; *size < len; /* nothing */) {
+		ch = (u_char)buf[*size];
+		if (ch < tks_state->first || ch - tks_state->first >=
+		    tks_state->count)
+			return (NULL);
+		state = tks->next[tks_state->base + ch - tks_state->first];
+		if (state == 0)
+			return (NULL);
+		tks_state = &tks->states[state];
 
-	/* Pick the next in the sequence. */
-	if (tk->ch == *buf) {
-		/* Move forward in the string. */
-		buf++; len--;
 		(*size)++;
-
-		/* At the end of the string, return the current node. */
-		if (len == 0 || (tk->next == NULL && tk->key != KEYC_UNKNOWN))
-			return (tk);
-
-		/* Move into the next tree for the following character. */
-		tk = tk->next;
-	} else {
-		if (*buf < tk->ch)
-			tk = tk->left;
-		else if (*buf > tk->ch)
-			tk = tk->right;
+		if (tks_state->count == 0 && tks_state->key != KEYC_UNKNOWN)
+			break;
 	}
-
-	/* Move to the next in the tree. */
-	return (tty_keys_find1(tk, buf, len, size));
+	if (*size == 0)
+		return (NULL);
+	return (tks_state);
 }
 
 static int
@@ -619,7 +740,7 @@ tty_keys_next1(struct tty *tty, const char *buf, size_t len, key_code *key,
     size_t *size, int expired)
 {
 	struct client		*c = tty->client;
-	struct tty_key		*tk, *tk1;
+	struct tty_key_state	*tks_state;
 	struct utf8_data	 ud;
 	enum utf8_state		 more;
 	utf8_char		 uc;
@@ -629,15 +750,13 @@ tty_keys_next1(struct tty *tty, const char *buf, size_t len, key_code *key,
 	    (int)len, buf, expired);
 
 	/* Is this a known key? */
-	tk = tty_keys_find(tty, buf, len, size);
-	if (tk != NULL && tk->key != KEYC_UNKNOWN) {
-		tk1 = tk;
-		do
-			log_debug("%s: keys in list: %#llx", c->name, tk1->key);
-		while ((tk1 = tk1->next) != NULL);
-		if (tk->next != NULL && !expired)
+	tks_state = tty_keys_find(tty, buf, len, size);
+	if (tks_state != NULL && tks_state->key != KEYC_UNKNOWN) {
+		log_debug("%s: key in table: %#llx (%u more)", c->name,
+		    tks_state->key, tks_state->count);
+		if (tks_state->count != 0 && !expired)
 			return (1);
-		*key = tk->key;
+		*key = tks_state->key;
 		if ((*key & KEYC_MASK_KEY) == KEYC_PASTE_START)
 			tty->flags |= TTY_BRACKETPASTE;
 		else if ((*key & KEYC_MASK_KEY) == KEYC_PASTE_END)
@@ -671,6 +790,30 @@ tty_keys_next1(struct tty *tty, const char *buf, size_t len, key_code *key,
 	return (-1);
 }
 
+/*
+ * Get the length of bracket pasted text at the start of the buffer, up to the
+ * paste end sequence or the end of the buffer if the end sequence has not
+ * arrived yet.
+ */
+static size_t
+tty_keys_paste_length(const char *buf, size_t len)
+{
+	static const char	 paste_end[] = "\033[201~";
+	size_t			 paste_end_len = (sizeof paste_end) - 1, i;
+	const char		*end;
+
+	end = memmem(buf, len, paste_end, paste_end_len);
+	if (end != NULL)
+		return (end - buf);
+
+	/* Leave any partial end sequence for next time. */
+	for (i = len > paste_end_len ? len - paste_end_len : 0; i < len; i++) {
+		if (tty_keys_partial_paste_end(buf + i, len - i))
+			return (i);
+	}
+	return (len);
+}
+
 /* Process window size change escape sequences. */
 static int
 tty_keys_winsz(struct tty *tty, const char *buf, size_t len, size_t *size)
@@ -760,6 +903,18 @@ tty_keys_next(struct tty *tty)
 		return (0);
 	log_debug("%s: keys are %zu (%.*s)", c->name, len, (int)len, buf);
 
+	/*
+	 * If bracket pasting, pass everything up to the end of the paste as one
+	 * key rather than working through it a key at a time.
+	 */
+	if ((tty->flags & TTY_BRACKETPASTE) &&
+	    server_client_can_bulk_paste(c) &&
+	    (size = tty_keys_paste_length(buf, len)) != 0) {
+		key = (u_char)*buf;
+		log_debug("%s: bulk paste of %zu", c->name, size);
+		goto complete_key;
+	}
+
 	/* Is this a clipboard response? */
 	switch (tty_keys_clipboard(tty, buf, len, &size)) {
 	case 0:		/* yes */
@@ -836,6 +991,8 @@ tty_keys_next(struct tty *tty)
 	switch (tty_keys_mouse(tty, buf, len, &size, &m)) {
 	case 0:		/* yes */
 		key = KEYC_MOUSE;
+		if (tty_keys_mouse_coalesce(tty, buf, len, size, &m))
+			goto discard_key;
 		goto complete_key;
 	case -1:	/* no, or not valid */
 		break;
@@ -1020,6 +1177,7 @@ complete_key:
 		event = xcalloc(1, sizeof *event);
 		event->key = key;
 		memcpy(&event->m, &m, sizeof event->m);
+		event->time = stats_time();
 
 		event->buf = xmalloc(size);
 		event->len = size;
@@ -1052,8 +1210,10 @@ tty_keys_callback(__unused int fd, __unused short events, void *data)
 	struct tty	*tty = data;
 
 	if (tty->flags & TTY_TIMER) {
+		tty->client->key_batch = NULL;
 		while (tty_keys_next(tty))
 			;
+		tty->client->key_batch = NULL;
 	}
 }
 
@@ -1323,6 +1483,38 @@ tty_keys_mouse(struct tty *tty, const char *buf, size_t len, size_t *size,
 	return (0);
 }
 
+/*
+ * Check if a mouse motion event is followed in the buffer by another with the
+ * same buttons, so it can be dropped in favour of the later one. The last
+ * position is put back so the later event moves from where this one started.
+ */
+static int
+tty_keys_mouse_coalesce(struct tty *tty, const char *buf, size_t len,
+    size_t size, struct mouse_event *m)
+{
+	struct client		*c = tty->client;
+	struct mouse_event	 m2 = { 0 };
+	size_t			 size2;
+
+	if (!MOUSE_DRAG(m->b) || size >= len)
+		return (0);
+	if (tty_keys_mouse(tty, buf + size, len - size, &size2, &m2) != 0 ||
+	    m2.b != m->b ||
+	    m2.sgr_type != m->sgr_type ||
+	    !server_client_can_coalesce_mouse(c)) {
+		tty->mouse_last_x = m->x;
+		tty->mouse_last_y = m->y;
+		tty->mouse_last_b = m->b;
+		return (0);
+	}
+	tty->mouse_last_x = m->lx;
+	tty->mouse_last_y = m->ly;
+	tty->mouse_last_b = m->lb;
+	log_debug("%s: coalescing mouse %u,%u with %u,%u", c->name, m->x, m->y,
+	    m2.x, m2.y);
+	return (1);
+}
+
 /*
  * Handle OSC 52 clipboard input. Returns 0 for success, -1 for failure, 1 for
  * partial.
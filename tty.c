@@ -177,6 +177,7 @@ tty_read_callback(__unused int fd, __unused short events, void *data)
 	const char	*name = c->name;
 	size_t		 size = EVBUFFER_LENGTH(tty->in);
 	int		 nread;
+	uint64_t	 t;
 
 	nread = evbuffer_read(tty->in, c->fd, -1);
 	if (nread == 0 || nread == -1) {
@@ -190,8 +191,13 @@ tty_read_callback(__unused int fd, __unused short events, void *data)
 	}
 	log_debug("%s: read %d bytes (already %zu)", name, nread, size);
 
+	/* Keys from the same read may be batched together. */
+	t = stats_time();
+	tty->client->key_batch = NULL;
 	while (tty_keys_next(tty))
 		;
+	tty->client->key_batch = NULL;
+	stats_stall(t, __func__, NULL, c, -1);
 }
 
 static void
@@ -205,6 +211,7 @@ tty_timer_callback(__unused int fd, __unused short events, void *data)
 
 	c->flags |= CLIENT_ALLREDRAWFLAGS;
 	c->discarded += tty->discarded;
+	global_stats.discarded += tty->discarded;
 
 	if (tty->discarded < TTY_BLOCK_STOP(tty)) {
 		tty->flags &= ~TTY_BLOCK;
@@ -238,6 +245,7 @@ tty_block_maybe(struct tty *tty)
 
 	evbuffer_drain(tty->out, size);
 	c->discarded += size;
+	global_stats.discarded += size;
 
 	tty->discarded = 0;
 	evtimer_add(&tty->timer, &tv);
@@ -256,6 +264,9 @@ tty_write_callback(__unused int fd, __unused short events, void *data)
 	if (nwrite == -1)
 		return;
 	log_debug("%s: wrote %d bytes (of %zu)", c->name, nwrite, size);
+	global_stats.output += nwrite;
+	if (nwrite != 0)
+		stats_echo_flush(c);
 
 	if (c->redraw > 0) {
 		if ((size_t)nwrite >= c->redraw)
@@ -2161,8 +2172,7 @@ tty_cmd_sixelimage(struct tty *tty, const struct tty_ctx *ctx)
 {
 	struct image		*im = ctx->image;
 	struct sixel_image	*si = im->data;
-	struct sixel_image	*new;
-	char			*data;
+	const char		*data;
 	size_t			 size;
 	u_int			 cx = ctx->ocx, cy = ctx->ocy, sx, sy;
 	u_int			 i, j, x, y, rx, ry;
@@ -2179,19 +2189,17 @@ tty_cmd_sixelimage(struct tty *tty, const struct tty_ctx *ctx)
 	if (!tty_clamp_area(tty, ctx, cx, cy, sx, sy, &i, &j, &x, &y, &rx, &ry))
 		return;
 	log_debug("%s: clamping to %u,%u-%u,%u", __func__, i, j, rx, ry);
+	image_used(im);
 
 	if (fallback == 1) {
-		data = xstrdup(im->fallback);
+		data = im->fallback;
 		size = strlen(data);
 	} else {
-		new = sixel_scale(si, tty->xpixel, tty->ypixel, i, j, rx, ry, 0);
-		if (new == NULL)
-			return;
-
-		data = sixel_print(new, si, &size);
+		data = image_print(im, tty->xpixel, tty->ypixel, i, j, rx, ry,
+		    &size);
 	}
 	if (data != NULL) {
-		log_debug("%s: %zu bytes: %s", __func__, size, data);
+		log_debug("%s: %zu bytes", __func__, size);
 		tty_region_off(tty);
 		tty_margin_off(tty);
 		tty_cursor(tty, x, y);
@@ -2199,11 +2207,7 @@ tty_cmd_sixelimage(struct tty *tty, const struct tty_ctx *ctx)
 		tty->flags |= TTY_NOBLOCK;
 		tty_add(tty, data, size);
 		tty_invalidate(tty);
-		free(data);
 	}
-
-	if (fallback == 0)
-		sixel_free(new);
 }
 #endif
 
@@ -215,71 +215,137 @@ static struct utf8_width_item utf8_default_width_cache[] = {
 	{ .wc = 0x1FAF8, .width = 2 }
 };
 
+/*
+ * Characters of more than three bytes are stored in a table and the grid
+ * keeps their index. Items are kept in an array by index and found by data
+ * through an open addressed hash table of indexes (plus one, so zero is an
+ * empty slot), so both directions are constant time.
+ *
+ * Items added for grids are collected once they are no longer used by any
+ * grid: when enough have been added since the last collection, every item
+ * used by a grid is marked and the rest are freed and their indexes reused.
+ * Items added elsewhere (such as for keys) are pinned and never freed.
+ */
+#define UTF8_COLLECT_MINIMUM 1024
 struct utf8_item {
-	RB_ENTRY(utf8_item)	index_entry;
-	u_int			index;
-
-	RB_ENTRY(utf8_item)	data_entry;
 	char			data[UTF8_SIZE];
 	u_char			size;
+
+	u_char			flags;
+#define UTF8_ITEM_PINNED 0x1
+#define UTF8_ITEM_MARKED 0x2
 };
+static struct utf8_item	*utf8_items;
+static u_int		 utf8_items_size;
+static u_int		*utf8_item_hash;
+static u_int		 utf8_item_hash_size;
 
-static int
-utf8_data_cmp(struct utf8_item *ui1, struct utf8_item *ui2)
-{
-	if (ui1->size < ui2->size)
-		return (-1);
-	if (ui1->size > ui2->size)
-		return (1);
-	return (memcmp(ui1->data, ui2->data, ui1->size));
-}
-RB_HEAD(utf8_data_tree, utf8_item);
-RB_GENERATE_STATIC(utf8_data_tree, utf8_item, data_entry, utf8_data_cmp);
-static struct utf8_data_tree utf8_data_tree = RB_INITIALIZER(utf8_data_tree);
+static u_int		*utf8_free_items;
+static u_int		 utf8_free_items_size;
+static u_int		 utf8_free_count;
 
-static int
-utf8_index_cmp(struct utf8_item *ui1, struct utf8_item *ui2)
-{
-	if (ui1->index < ui2->index)
-		return (-1);
-	if (ui1->index > ui2->index)
-		return (1);
-	return (0);
-}
-RB_HEAD(utf8_index_tree, utf8_item);
-RB_GENERATE_STATIC(utf8_index_tree, utf8_item, index_entry, utf8_index_cmp);
-static struct utf8_index_tree utf8_index_tree = RB_INITIALIZER(utf8_index_tree);
+static u_int		 utf8_item_count;
+static u_int		 utf8_collect_limit = UTF8_COLLECT_MINIMUM;
+static int		 utf8_collect_queued;
 
 static int	utf8_no_width;
 static u_int	utf8_next_index;
 
+/*
+ * Flat table of known widths for the first two Unicode planes, which is where
+ * nearly all characters seen in practice are. It is split into pages which
+ * are allocated when first used. Each entry is the width plus one, or zero if
+ * not yet known.
+ */
+#define UTF8_WIDTH_TABLE_SIZE 0x20000
+#define UTF8_WIDTH_PAGE_SIZE 256
+static u_char	*utf8_width_table[UTF8_WIDTH_TABLE_SIZE / UTF8_WIDTH_PAGE_SIZE];
+
+/* Bytes repeated in each byte of a word, for checking a word at a time. */
+#define UTF8_WORD_ONES 0x0101010101010101ULL
+#define UTF8_WORD_HIGHS 0x8080808080808080ULL
+#define UTF8_WORD_HAS_ZERO(w) \
+	((((w) - UTF8_WORD_ONES) & ~(w) & UTF8_WORD_HIGHS) != 0)
+
 #define UTF8_GET_SIZE(uc) (((uc) >> 24) & 0x1f)
 #define UTF8_GET_WIDTH(uc) (((uc) >> 29) - 1)
 
 #define UTF8_SET_SIZE(size) (((utf8_char)(size)) << 24)
 #define UTF8_SET_WIDTH(width) ((((utf8_char)(width)) + 1) << 29)
 
-/* Get a UTF-8 item from data. */
-static struct utf8_item *
-utf8_item_by_data(const u_char *data, size_t size)
+/* Hash UTF-8 item data. */
+static u_int
+utf8_item_hash_data(const u_char *data, size_t size)
+{
+	u_int	hash = 2166136261U;
+	size_t	i;
+
+	for (i = 0; i < size; i++) {
+		hash ^= data[i];
+		hash *= 16777619U;
+	}
+	return (hash);
+}
+
+/* Get the hash slot for UTF-8 item data, either its own or an empty one. */
+static u_int *
+utf8_item_slot(const u_char *data, size_t size)
+{
+	struct utf8_item	*ui;
+	u_int			 mask = utf8_item_hash_size - 1, slot;
+
+	slot = utf8_item_hash_data(data, size) & mask;
+	for (;;) {
+		if (utf8_item_hash[slot] == 0)
+			break;
+		ui = &utf8_items[utf8_item_hash[slot] - 1];
+		if (ui->size == size && memcmp(ui->data, data, size) == 0)
+			break;
+		slot = (slot + 1) & mask;
+	}
+	return (&utf8_item_hash[slot]);
+}
+
+/* Resize the hash table and add all the items back. */
+static void
+utf8_item_rehash(u_int size)
 {
-	struct utf8_item	ui;
+	struct utf8_item	*ui;
+	u_int			 i;
 
-	memcpy(ui.data, data, size);
-	ui.size = size;
+	free(utf8_item_hash);
+	utf8_item_hash_size = size;
+	utf8_item_hash = xcalloc(utf8_item_hash_size, sizeof *utf8_item_hash);
 
-	return (RB_FIND(utf8_data_tree, &utf8_data_tree, &ui));
+	for (i = 0; i < utf8_next_index; i++) {
+		ui = &utf8_items[i];
+		if (ui->size != 0)
+			*utf8_item_slot(ui->data, ui->size) = i + 1;
+	}
 }
 
 /* Get a UTF-8 item from data. */
-static struct utf8_item *
-utf8_item_by_index(u_int index)
+static int
+utf8_item_by_data(const u_char *data, size_t size, u_int *index)
 {
-	struct utf8_item	ui;
+	u_int	*slot;
 
-	ui.index = index;
+	if (utf8_item_hash_size == 0)
+		return (-1);
+	slot = utf8_item_slot(data, size);
+	if (*slot == 0)
+		return (-1);
+	*index = *slot - 1;
+	return (0);
+}
 
-	return (RB_FIND(utf8_index_tree, &utf8_index_tree, &ui));
+/* Get a UTF-8 item from index. */
+static struct utf8_item *
+utf8_item_by_index(u_int index)
+{
+	if (index >= utf8_next_index || utf8_items[index].size == 0)
+		return (NULL);
+	return (&utf8_items[index]);
 }
 
 /* Find a codepoint in the cache. */
@@ -292,6 +358,47 @@ utf8_find_in_width_cache(wchar_t wc)
 	return RB_FIND(utf8_width_cache, &utf8_width_cache, &uw);
 }
 
+/* Look up a codepoint in the width table. */
+static int
+utf8_width_table_get(wchar_t wc, int *width)
+{
+	u_char	*page;
+
+	if (wc < 0 || wc >= UTF8_WIDTH_TABLE_SIZE)
+		return (0);
+	page = utf8_width_table[wc / UTF8_WIDTH_PAGE_SIZE];
+	if (page == NULL || page[wc % UTF8_WIDTH_PAGE_SIZE] == 0)
+		return (0);
+	*width = page[wc % UTF8_WIDTH_PAGE_SIZE] - 1;
+	return (1);
+}
+
+/* Add a codepoint to the width table. */
+static void
+utf8_width_table_set(wchar_t wc, int width)
+{
+	u_char	**page;
+
+	if (wc < 0 || wc >= UTF8_WIDTH_TABLE_SIZE || width < 0 || width > 0xfe)
+		return;
+	page = &utf8_width_table[wc / UTF8_WIDTH_PAGE_SIZE];
+	if (*page == NULL)
+		*page = xcalloc(1, UTF8_WIDTH_PAGE_SIZE);
+	(*page)[wc % UTF8_WIDTH_PAGE_SIZE] = width + 1;
+}
+
+/* Empty the width table. */
+static void
+utf8_width_table_clear(void)
+{
+	u_int	i;
+
+	for (i = 0; i < nitems(utf8_width_table); i++) {
+		free(utf8_width_table[i]);
+		utf8_width_table[i] = NULL;
+	}
+}
+
 /* Add to width cache. */
 static void
 utf8_insert_width_cache(wchar_t wc, u_int width)
@@ -416,6 +523,7 @@ utf8_update_width_cache(void)
 		if (uw->allocated)
 			free(uw);
 	}
+	utf8_width_table_clear();
 
 	for (i = 0; i < nitems(utf8_default_width_cache); i++) {
 		RB_INSERT(utf8_width_cache, &utf8_width_cache,
@@ -430,39 +538,125 @@ utf8_update_width_cache(void)
 	}
 }
 
+/* Mark a UTF-8 character as in use. */
+void
+utf8_mark(utf8_char uc)
+{
+	u_int	index;
+
+	if (UTF8_GET_SIZE(uc) <= 3)
+		return;
+	index = (uc & 0xffffff);
+	if (index < utf8_next_index)
+		utf8_items[index].flags |= UTF8_ITEM_MARKED;
+}
+
+/* Free UTF-8 items which are no longer used by any grid. */
+static void
+utf8_collect(__unused int fd, __unused short events, __unused void *arg)
+{
+	struct utf8_item	*ui;
+	u_int			 i, freed = 0;
+
+	utf8_collect_queued = 0;
+
+	for (i = 0; i < utf8_next_index; i++)
+		utf8_items[i].flags &= ~UTF8_ITEM_MARKED;
+	grid_mark_utf8();
+
+	for (i = 0; i < utf8_next_index; i++) {
+		ui = &utf8_items[i];
+		if (ui->size == 0 || (ui->flags & (UTF8_ITEM_PINNED|
+		    UTF8_ITEM_MARKED)))
+			continue;
+		ui->size = 0;
+		if (utf8_free_count == utf8_free_items_size) {
+			utf8_free_items_size = utf8_items_size;
+			utf8_free_items = xreallocarray(utf8_free_items,
+			    utf8_free_items_size, sizeof *utf8_free_items);
+		}
+		utf8_free_items[utf8_free_count++] = i;
+		freed++;
+	}
+	utf8_item_count -= freed;
+	if (freed != 0)
+		utf8_item_rehash(utf8_item_hash_size);
+
+	utf8_collect_limit = utf8_item_count * 2;
+	if (utf8_collect_limit < UTF8_COLLECT_MINIMUM)
+		utf8_collect_limit = UTF8_COLLECT_MINIMUM;
+	log_debug("%s: freed %u, %u left, next at %u", __func__, freed,
+	    utf8_item_count, utf8_collect_limit);
+}
+
 /* Add a UTF-8 item. */
 static int
-utf8_put_item(const u_char *data, size_t size, u_int *index)
+utf8_put_item(const u_char *data, size_t size, int pinned, u_int *index)
 {
 	struct utf8_item	*ui;
 
-	ui = utf8_item_by_data(data, size);
-	if (ui != NULL) {
-		*index = ui->index;
+	if (utf8_item_by_data(data, size, index) == 0) {
+		if (pinned)
+			utf8_items[*index].flags |= UTF8_ITEM_PINNED;
 		log_debug("%s: found %.*s = %u", __func__, (int)size, data,
 		    *index);
 		return (0);
 	}
 
-	if (utf8_next_index == 0xffffff + 1)
-		return (-1);
-
-	ui = xcalloc(1, sizeof *ui);
-	ui->index = utf8_next_index++;
-	RB_INSERT(utf8_index_tree, &utf8_index_tree, ui);
-
+	if (utf8_free_count != 0)
+		*index = utf8_free_items[--utf8_free_count];
+	else {
+		if (utf8_next_index == 0xffffff + 1)
+			return (-1);
+		if (utf8_next_index == utf8_items_size) {
+			if (utf8_items_size == 0)
+				utf8_items_size = 64;
+			else
+				utf8_items_size *= 2;
+			utf8_items = xreallocarray(utf8_items, utf8_items_size,
+			    sizeof *utf8_items);
+		}
+		*index = utf8_next_index++;
+	}
+	ui = &utf8_items[*index];
 	memcpy(ui->data, data, size);
 	ui->size = size;
-	RB_INSERT(utf8_data_tree, &utf8_data_tree, ui);
+	ui->flags = pinned ? UTF8_ITEM_PINNED : 0;
+
+	if (++utf8_item_count * 2 > utf8_item_hash_size) {
+		if (utf8_item_hash_size == 0)
+			utf8_item_rehash(256);
+		else
+			utf8_item_rehash(utf8_item_hash_size * 2);
+	} else
+		*utf8_item_slot(data, size) = *index + 1;
+
+	if (!pinned &&
+	    utf8_item_count >= utf8_collect_limit &&
+	    !utf8_collect_queued) {
+		event_once(-1, EV_TIMEOUT, utf8_collect, NULL, NULL);
+		utf8_collect_queued = 1;
+	}
 
-	*index = ui->index;
 	log_debug("%s: added %.*s = %u", __func__, (int)size, data, *index);
 	return (0);
 }
 
+/* Get a placeholder UTF-8 character of the same width for data. */
+static void
+utf8_placeholder(const struct utf8_data *ud, utf8_char *uc)
+{
+	if (ud->width == 0)
+		*uc = UTF8_SET_SIZE(0)|UTF8_SET_WIDTH(0);
+	else if (ud->width == 1)
+		*uc = UTF8_SET_SIZE(1)|UTF8_SET_WIDTH(1)|0x20;
+	else
+		*uc = UTF8_SET_SIZE(1)|UTF8_SET_WIDTH(1)|0x2020;
+}
+
 /* Get UTF-8 character from data. */
-enum utf8_state
-utf8_from_data(const struct utf8_data *ud, utf8_char *uc)
+static enum utf8_state
+utf8_from_data1(const struct utf8_data *ud, int pinned, utf8_char *uc)
 {
 	u_int	index;
 
@@ -475,7 +669,7 @@ utf8_from_data(const struct utf8_data *ud, utf8_char *uc)
 		index = (((utf8_char)ud->data[2] << 16)|
 			  ((utf8_char)ud->data[1] << 8)|
 			  ((utf8_char)ud->data[0]));
-	} else if (utf8_put_item(ud->data, ud->size, &index) != 0)
+	} else if (utf8_put_item(ud->data, ud->size, pinned, &index) != 0)
 		goto fail;
 	*uc = UTF8_SET_SIZE(ud->size)|UTF8_SET_WIDTH(ud->width)|index;
 	log_debug("%s: (%d %d %.*s) -> %08x", __func__, ud->width, ud->size,
@@ -483,15 +677,50 @@ utf8_from_data(const struct utf8_data *ud, utf8_char *uc)
 	return (UTF8_DONE);
 
 fail:
-	if (ud->width == 0)
-		*uc = UTF8_SET_SIZE(0)|UTF8_SET_WIDTH(0);
-	else if (ud->width == 1)
-		*uc = UTF8_SET_SIZE(1)|UTF8_SET_WIDTH(1)|0x20;
-	else
-		*uc = UTF8_SET_SIZE(1)|UTF8_SET_WIDTH(1)|0x2020;
+	utf8_placeholder(ud, uc);
 	return (UTF8_ERROR);
 }
 
+/* Get UTF-8 character from data. The character is never freed. */
+enum utf8_state
+utf8_from_data(const struct utf8_data *ud, utf8_char *uc)
+{
+	return (utf8_from_data1(ud, 1, uc));
+}
+
+/*
+ * Get UTF-8 character from data to be stored in a grid. The character may be
+ * freed once no grid uses it.
+ */
+enum utf8_state
+utf8_from_grid_data(const struct utf8_data *ud, utf8_char *uc)
+{
+	return (utf8_from_data1(ud, 0, uc));
+}
+
+/*
+ * Get UTF-8 character for data taken from a grid, which should already be
+ * known. Nothing is ever added (unknown data gets a placeholder), so this is
+ * safe to use while reflowing on threads.
+ */
+void
+utf8_find_grid_data(const struct utf8_data *ud, utf8_char *uc)
+{
+	u_int	index;
+
+	if (ud->size > UTF8_SIZE)
+		utf8_placeholder(ud, uc);
+	else if (ud->size <= 3) {
+		index = (((utf8_char)ud->data[2] << 16)|
+			  ((utf8_char)ud->data[1] << 8)|
+			  ((utf8_char)ud->data[0]));
+		*uc = UTF8_SET_SIZE(ud->size)|UTF8_SET_WIDTH(ud->width)|index;
+	} else if (utf8_item_by_data(ud->data, ud->size, &index) != 0)
+		utf8_placeholder(ud, uc);
+	else
+		*uc = UTF8_SET_SIZE(ud->size)|UTF8_SET_WIDTH(ud->width)|index;
+}
+
 /* Get UTF-8 data from character. */
 void
 utf8_to_data(utf8_char uc, struct utf8_data *ud)
@@ -557,10 +786,13 @@ utf8_width(struct utf8_data *ud, int *width)
 
 	if (utf8_towc(ud, &wc) != UTF8_DONE)
 		return (UTF8_ERROR);
+	if (utf8_width_table_get(wc, width))
+		return (UTF8_DONE);
 	uw = utf8_find_in_width_cache(wc);
 	if (uw != NULL) {
 		*width = uw->width;
 		log_debug("cached width for %08X is %d", (u_int)wc, *width);
+		utf8_width_table_set(wc, *width);
 		return (UTF8_DONE);
 	}
 #ifdef HAVE_UTF8PROC
@@ -577,8 +809,10 @@ utf8_width(struct utf8_data *ud, int *width)
 		*width = (wc >= 0x80 && wc <= 0x9f) ? 0 : 1;
 	}
 #endif
-	if (*width >= 0 && *width <= 0xff)
+	if (*width >= 0 && *width <= 0xff) {
+		utf8_width_table_set(wc, *width);
 		return (UTF8_DONE);
+	}
 	return (UTF8_ERROR);
 }
 
@@ -888,6 +1122,38 @@ utf8_tocstr(struct utf8_data *src)
 	return (dst);
 }
 
+/*
+ * Get the number of bytes at the start of a string which are printable ASCII
+ * (and not the stop character, if any). This checks a word at a time, so
+ * mostly ASCII strings are skipped quickly.
+ */
+size_t
+utf8_ascii_span(const char *s, size_t len, u_char stop)
+{
+	uint64_t	w;
+	size_t		n = 0;
+	u_char		ch;
+
+	while (len - n >= sizeof w) {
+		memcpy(&w, s + n, sizeof w);
+		if (w & UTF8_WORD_HIGHS)
+			break;
+		if (((w - UTF8_WORD_ONES * 0x20) & ~w & UTF8_WORD_HIGHS) != 0)
+			break;
+		if (UTF8_WORD_HAS_ZERO(w ^ (UTF8_WORD_ONES * 0x7f)))
+			break;
+		if (stop != '\0' && UTF8_WORD_HAS_ZERO(w ^ (UTF8_WORD_ONES * stop)))
+			break;
+		n += sizeof w;
+	}
+	for (; n < len; n++) {
+		ch = s[n];
+		if (ch < 0x20 || ch > 0x7e || (stop != '\0' && ch == stop))
+			break;
+	}
+	return (n);
+}
+
 /* Get width of UTF-8 string. */
 u_int
 utf8_cstrwidth(const char *s)
@@ -895,9 +1161,17 @@ utf8_cstrwidth(const char *s)
 	struct utf8_data	tmp;
 	u_int			width;
 	enum utf8_state		more;
+	const char		*end = s + strlen(s);
+	size_t			n;
 
 	width = 0;
 	while (*s != '\0') {
+		n = utf8_ascii_span(s, end - s, '\0');
+		if (n != 0) {
+			width += n;
+			s += n;
+			continue;
+		}
 		if ((more = utf8_open(&tmp, *s)) == UTF8_MORE) {
 			while (*++s != '\0' && more == UTF8_MORE)
 				more = utf8_append(&tmp, *s);
@@ -391,6 +391,7 @@ window_copy_clone_screen(struct screen *src, struct screen *hint, u_int *cx,
 
 	dst = xcalloc(1, sizeof *dst);
 
+	grid_reflow_finish(src->grid);
 	sy = screen_hsize(src) + screen_size_y(src);
 	if (trim) {
 		while (sy > screen_hsize(src)) {
@@ -919,8 +919,7 @@ window_tree_search(__unused void *modedata, void *itemdata, const char *ss,
 	struct session			*s;
 	struct winlink			*wl;
 	struct window_pane		*wp;
-	char				*cmd;
-	int				 retval;
+	const char			*cmd;
 
 	window_tree_pull_item(item, &s, &wl, &wp);
 
@@ -942,17 +941,12 @@ window_tree_search(__unused void *modedata, void *itemdata, const char *ss,
 	case WINDOW_TREE_PANE:
 		if (s == NULL || wl == NULL || wp == NULL)
 			break;
-		cmd = osdep_get_name(wp->fd, wp->tty);
-		if (cmd == NULL || *cmd == '\0') {
-			free(cmd);
+		cmd = window_pane_current_command(wp);
+		if (cmd == NULL || *cmd == '\0')
 			return (0);
-		}
 		if (icase)
-			retval = (strcasestr(cmd, ss) != NULL);
-		else
-			retval = (strstr(cmd, ss) != NULL);
-		free(cmd);
-		return (retval);
+			return (strcasestr(cmd, ss) != NULL);
+		return (strstr(cmd, ss) != NULL);
 	}
 	return (0);
 }
@@ -62,6 +62,22 @@ static u_int	next_window_pane_id;
 static u_int	next_window_id;
 static u_int	next_active_point;
 
+/*
+ * Maximum time the cached foreground process details are kept, and the
+ * minimum time before they are read again because the pane had output.
+ */
+#define WINDOW_PANE_PROC_INTERVAL 5000
+#define WINDOW_PANE_PROC_STALE_INTERVAL 1000
+
+/*
+ * Bytes read from a pane between checks against pane-memory-limit, fewer as it
+ * gets close to the limit. Each byte read is assumed to use at most
+ * WINDOW_PANE_MEMORY_RATIO bytes of memory.
+ */
+#define WINDOW_PANE_MEMORY_CHECK 65536
+#define WINDOW_PANE_MEMORY_MINIMUM 1024
+#define WINDOW_PANE_MEMORY_RATIO 32
+
 struct window_pane_input_data {
 	struct cmdq_item	*item;
 	u_int			 wp;
@@ -405,8 +421,9 @@ window_create(u_int sx, u_int sy, u_int xpixel, u_int ypixel)
 	w->ypixel = ypixel;
 
 	w->options = options_create(global_w_options);
-	w->sb = options_get_number(w->options, "pane-scrollbars");
-	w->sb_pos = options_get_number(w->options, "pane-scrollbars-position");
+	w->sb = options_get_number_id(w->options, OPTION_PANE_SCROLLBARS);
+	w->sb_pos = options_get_number_id(w->options,
+	    OPTION_PANE_SCROLLBARS_POSITION);
 
 	w->references = 0;
 	TAILQ_INIT(&w->winlinks);
@@ -446,6 +463,8 @@ window_destroy(struct window *w)
 		evtimer_del(&w->alerts_timer);
 	if (event_initialized(&w->offset_timer))
 		event_del(&w->offset_timer);
+	if (event_initialized(&w->resize_timer))
+		evtimer_del(&w->resize_timer);
 
 	options_free(w->options);
 	free(w->fill_character);
@@ -668,7 +687,7 @@ window_set_active_pane(struct window *w, struct window_pane *wp, int notify)
 	w->active->active_point = next_active_point++;
 	w->active->flags |= PANE_CHANGED;
 
-	if (options_get_number(global_options, "focus-events")) {
+	if (options_get_number_id(global_options, OPTION_FOCUS_EVENTS)) {
 		window_pane_update_focus(lastwp);
 		window_pane_update_focus(w->active);
 	}
@@ -1002,7 +1021,7 @@ window_pane_at_index(struct window *w, u_int idx)
 	struct window_pane	*wp;
 	u_int			 n;
 
-	n = options_get_number(w->options, "pane-base-index");
+	n = options_get_number_id(w->options, OPTION_PANE_BASE_INDEX);
 	TAILQ_FOREACH(wp, &w->panes, entry) {
 		if (n == idx)
 			return (wp);
@@ -1040,7 +1059,7 @@ window_pane_index(struct window_pane *wp, u_int *i)
 	struct window		*w = wp->window;
 	struct window_pane	*wq;
 
-	*i = options_get_number(w->options, "pane-base-index");
+	*i = options_get_number_id(w->options, OPTION_PANE_BASE_INDEX);
 	TAILQ_FOREACH(wq, &w->panes, entry) {
 		if (wp == wq) {
 			return (0);
@@ -1149,6 +1168,60 @@ window_pane_printable_flags(struct window_pane *wp)
 	return (flags);
 }
 
+/*
+ * Update the cached foreground process name and working directory. These are
+ * read again when the foreground process group changes, when the pane has
+ * had output (a shell may have changed directory) but not more than once a
+ * second, or after an interval.
+ */
+static void
+window_pane_update_proc(struct window_pane *wp)
+{
+	uint64_t	 now = get_timer();
+	pid_t		 pgrp = -1;
+	char		*cwd;
+
+	if (wp->fd != -1)
+		pgrp = tcgetpgrp(wp->fd);
+	if (pgrp == wp->proc_pgrp &&
+	    ((~wp->flags & PANE_PROCSTALE) ||
+	    now - wp->proc_time < WINDOW_PANE_PROC_STALE_INTERVAL) &&
+	    now - wp->proc_time < WINDOW_PANE_PROC_INTERVAL)
+		return;
+	wp->proc_pgrp = pgrp;
+	wp->flags &= ~PANE_PROCSTALE;
+	wp->proc_time = now;
+
+	free(wp->proc_name);
+	free(wp->proc_cwd);
+	wp->proc_name = wp->proc_cwd = NULL;
+	if (pgrp == -1)
+		return;
+
+	wp->proc_name = osdep_get_name(wp->fd, wp->tty);
+	if ((cwd = osdep_get_cwd(wp->fd)) != NULL)
+		wp->proc_cwd = xstrdup(cwd);
+	log_debug("%s: %%%u pgrp %ld is %s in %s", __func__, wp->id, (long)pgrp,
+	    wp->proc_name == NULL ? "(null)" : wp->proc_name,
+	    wp->proc_cwd == NULL ? "(null)" : wp->proc_cwd);
+}
+
+/* Get the name of the foreground process in a pane. */
+const char *
+window_pane_current_command(struct window_pane *wp)
+{
+	window_pane_update_proc(wp);
+	return (wp->proc_name);
+}
+
+/* Get the working directory of the foreground process in a pane. */
+const char *
+window_pane_current_path(struct window_pane *wp)
+{
+	window_pane_update_proc(wp);
+	return (wp->proc_cwd);
+}
+
 struct window_pane *
 window_pane_find_by_id_str(const char *s)
 {
@@ -1190,6 +1263,7 @@ window_pane_create(struct window *w, u_int sx, u_int sy, u_int hlimit)
 	RB_INSERT(window_pane_tree, &all_window_panes, wp);
 
 	wp->fd = -1;
+	wp->proc_pgrp = -1;
 
 	TAILQ_INIT(&wp->modes);
 
@@ -1210,6 +1284,7 @@ window_pane_create(struct window *w, u_int sx, u_int sy, u_int hlimit)
 	colour_palette_from_option(&wp->palette, wp->options);
 
 	screen_init(&wp->base, sx, sy, hlimit);
+	wp->base.grid->flags |= GRID_LAZYREFLOW;
 	wp->screen = &wp->base;
 	window_pane_default_cursor(wp);
 
@@ -1349,6 +1424,136 @@ window_pane_destroy(struct window_pane *wp)
 	window_pane_remove_ref(wp, __func__);
 }
 
+/* Get the memory used by a pane in bytes, not including any modes. */
+size_t
+window_pane_memory(struct window_pane *wp)
+{
+	struct screen	*s = &wp->base;
+	size_t		 size;
+
+	size = grid_memory(s->grid);
+	if (s->saved_grid != NULL)
+		size += grid_memory(s->saved_grid);
+	if (s->hyperlinks != NULL)
+		size += hyperlinks_memory(s->hyperlinks);
+#ifdef ENABLE_SIXEL
+	size += image_memory(s);
+#endif
+	if (wp->event != NULL)
+		size += EVBUFFER_LENGTH(wp->event->input);
+	return (size);
+}
+
+/*
+ * Check a pane against pane-memory-limit. If it is over, remove any images
+ * then the oldest history until it is back under three quarters of the limit,
+ * so this does not happen again for every line. If that is not enough and
+ * there is input waiting, return 1 to stop reading until there is less.
+ */
+int
+window_pane_check_memory(struct window_pane *wp)
+{
+	struct screen	*s = &wp->base;
+	size_t		 limit, size, target, next;
+	long long	 n;
+	u_int		 ny;
+#ifdef ENABLE_SIXEL
+	int		 freed;
+#endif
+
+	n = options_get_number_id(wp->options, OPTION_PANE_MEMORY_LIMIT);
+	if (n == 0) {
+		wp->memory_next = wp->input_bytes + WINDOW_PANE_MEMORY_CHECK;
+		goto out;
+	}
+	if ((unsigned long long)n > SIZE_MAX)
+		limit = SIZE_MAX;
+	else
+		limit = n;
+	size = window_pane_memory(wp);
+
+	if (size > limit) {
+		log_debug("%s: %%%u using %zu bytes (limit %zu)", __func__,
+		    wp->id, size, limit);
+		target = limit / 4 * 3;
+#ifdef ENABLE_SIXEL
+		freed = image_free_saved(s);
+		if (image_free_all(s)) {
+			wp->flags |= PANE_REDRAW;
+			freed = 1;
+		}
+		if (freed) {
+			log_debug("%s: %%%u removed images", __func__, wp->id);
+			size = window_pane_memory(wp);
+		}
+#endif
+		if (size > target && s->saved_grid != NULL) {
+			ny = grid_free_history_memory(s->saved_grid,
+			    size - target);
+			if (ny != 0) {
+				log_debug("%s: %%%u removed %u saved history "
+				    "lines", __func__, wp->id, ny);
+				size = window_pane_memory(wp);
+			}
+		}
+		if (size > target) {
+			ny = grid_free_history_memory(s->grid, size - target);
+			if (ny != 0) {
+				log_debug("%s: %%%u removed %u history lines",
+				    __func__, wp->id, ny);
+				wp->flags |= PANE_REDRAWSCROLLBAR;
+				size = window_pane_memory(wp);
+			}
+		}
+	}
+
+	/*
+	 * Check again before the output read could have used up the space
+	 * left, assuming the worst case for how much memory it may need.
+	 */
+	next = 0;
+	if (size < limit)
+		next = (limit - size) / WINDOW_PANE_MEMORY_RATIO;
+	if (next < WINDOW_PANE_MEMORY_MINIMUM)
+		next = WINDOW_PANE_MEMORY_MINIMUM;
+	if (next > WINDOW_PANE_MEMORY_CHECK)
+		next = WINDOW_PANE_MEMORY_CHECK;
+	wp->memory_next = wp->input_bytes + next;
+
+	if (size > limit &&
+	    wp->event != NULL &&
+	    EVBUFFER_LENGTH(wp->event->input) != 0) {
+		if (~wp->flags & PANE_MEMORYLIMIT) {
+			log_debug("%s: %%%u stopped reading", __func__,
+			    wp->id);
+		}
+		wp->flags |= PANE_MEMORYLIMIT;
+		wp->memory_buffered = EVBUFFER_LENGTH(wp->event->input);
+		return (1);
+	}
+
+out:
+	if (wp->flags & PANE_MEMORYLIMIT)
+		log_debug("%s: %%%u started reading", __func__, wp->id);
+	wp->flags &= ~PANE_MEMORYLIMIT;
+	return (0);
+}
+
+/*
+ * Check if a pane stopped by pane-memory-limit may read again. This is called
+ * every time round the server loop, but the memory used by a pane that is not
+ * reading changes little except when the waiting output is used, so the full
+ * check is only done again once some of that has gone.
+ */
+int
+window_pane_check_memory_stopped(struct window_pane *wp)
+{
+	if (wp->event != NULL &&
+	    EVBUFFER_LENGTH(wp->event->input) == wp->memory_buffered)
+		return (1);
+	return (window_pane_check_memory(wp));
+}
+
 static void
 window_pane_free(struct window_pane *wp)
 {
@@ -1361,6 +1566,8 @@ window_pane_free(struct window_pane *wp)
 
 	options_free(wp->options);
 	free((void *)wp->cwd);
+	free(wp->proc_name);
+	free(wp->proc_cwd);
 	free(wp->shell);
 	cmd_free_argv(wp->argc, wp->argv);
 	colour_palette_free(&wp->palette);
@@ -1378,7 +1585,9 @@ window_pane_read_callback(__unused struct bufferevent *bufev, void *data)
 	char				*new_data;
 	size_t				 new_size;
 	struct client			*c;
+	uint64_t			 t;
 
+	t = stats_time();
 	if (wp->pipe_fd != -1) {
 		new_data = window_pane_get_new_data(wp, wpo, &new_size);
 		if (new_size > 0) {
@@ -1388,12 +1597,19 @@ window_pane_read_callback(__unused struct bufferevent *bufev, void *data)
 	}
 
 	log_debug("%%%u has %zu bytes", wp->id, size);
+	wp->flags |= PANE_PROCSTALE;
 	TAILQ_FOREACH(c, &clients, entry) {
 		if (c->session != NULL && (c->flags & CLIENT_CONTROL))
 			control_write_output(c, wp);
 	}
+	stats_echo_read(wp);
 	input_parse_pane(wp);
 	bufferevent_disable(wp->event, EV_READ);
+
+	if (wp->input_bytes >= wp->memory_next)
+		window_pane_check_memory(wp);
+
+	stats_stall(t, __func__, NULL, NULL, wp->id);
 }
 
 static void
@@ -1757,7 +1973,8 @@ window_pane_copy_paste(struct window_pane *wp, char *buf, size_t len)
 		    loop->fd != -1 &&
 		    (~loop->flags & PANE_INPUTOFF) &&
 		    window_pane_is_visible(loop) &&
-		    options_get_number(loop->options, "synchronize-panes")) {
+		    options_get_number_id(loop->options,
+		    OPTION_SYNCHRONIZE_PANES)) {
 			log_debug("%s: %.*s", __func__, (int)len, buf);
 			bufferevent_write(loop->event, buf, len);
 		}
@@ -1775,7 +1992,8 @@ window_pane_copy_key(struct window_pane *wp, key_code key)
 		    loop->fd != -1 &&
 		    (~loop->flags & PANE_INPUTOFF) &&
 		    window_pane_is_visible(loop) &&
-		    options_get_number(loop->options, "synchronize-panes"))
+		    options_get_number_id(loop->options,
+		    OPTION_SYNCHRONIZE_PANES))
 			input_key_pane(loop, key, NULL);
 	}
 }
@@ -1795,7 +2013,7 @@ window_pane_paste(struct window_pane *wp, key_code key, char *buf, size_t len)
 	log_debug("%s: %.*s", __func__, (int)len, buf);
 	bufferevent_write(wp->event, buf, len);
 
-	if (options_get_number(wp->options, "synchronize-panes"))
+	if (options_get_number_id(wp->options, OPTION_SYNCHRONIZE_PANES))
 		window_pane_copy_paste(wp, buf, len);
 }
 
@@ -1831,7 +2049,7 @@ window_pane_key(struct window_pane *wp, struct client *c, struct session *s,
 
 	if (KEYC_IS_MOUSE(key))
 		return (0);
-	if (options_get_number(wp->options, "synchronize-panes"))
+	if (options_get_number_id(wp->options, OPTION_SYNCHRONIZE_PANES))
 		window_pane_copy_key(wp, key);
 	return (0);
 }
@@ -2320,7 +2538,7 @@ window_set_fill_character(struct window *w)
 	free(w->fill_character);
 	w->fill_character = NULL;
 
-	value = options_get_string(w->options, "fill-character");
+	value = options_get_string_id(w->options, OPTION_FILL_CHARACTER);
 	if (*value != '\0' && utf8_isvalid(value)) {
 		ud = utf8_fromcstr(value);
 		if (ud != NULL && ud[0].width == 1)
@@ -2639,7 +2857,7 @@ window_get_pane_lines(struct window *w)
 	struct options	*oo;
 
 	oo = w->options;
-	return (options_get_number(oo, "pane-border-lines"));
+	return (options_get_number_id(oo, OPTION_PANE_BORDER_LINES));
 }
 
 enum pane_lines
@@ -2651,7 +2869,7 @@ window_pane_get_pane_lines(struct window_pane *wp)
 		oo = wp->window->options;
 	else
 		oo = wp->options;
-	return (options_get_number(oo, "pane-border-lines"));
+	return (options_get_number_id(oo, OPTION_PANE_BORDER_LINES));
 }
 
 int
@@ -2659,7 +2877,7 @@ window_get_pane_status(struct window *w)
 {
 	int	status;
 
-	status = options_get_number(w->options, "pane-border-status");
+	status = options_get_number_id(w->options, OPTION_PANE_BORDER_STATUS);
 	if (status == PANE_STATUS_TOP_FLOATING ||
 	    status == PANE_STATUS_BOTTOM_FLOATING)
 		return (PANE_STATUS_OFF);
@@ -2676,7 +2894,7 @@ window_pane_get_pane_status(struct window_pane *wp)
 	if (window_pane_get_pane_lines(wp) == PANE_LINES_NONE)
 		return (PANE_STATUS_OFF);
 
-	status = options_get_number(wp->options, "pane-border-status");
+	status = options_get_number_id(wp->options, OPTION_PANE_BORDER_STATUS);
 	if (status == PANE_STATUS_TOP_FLOATING)
 		return (PANE_STATUS_TOP);
 	if (status == PANE_STATUS_BOTTOM_FLOATING)
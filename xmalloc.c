@@ -23,13 +23,66 @@
 
 #include "tmux.h"
 
+#ifdef NEED_BENCHMARKS
+/* Number of allocations made, reported by the benchmarks. */
+uint64_t		 xmalloc_count;
+#endif
+
+/* Files which have made allocations while accounting was on. */
+struct xmalloc_tag	*xmalloc_tags;
+static int		 xmalloc_accounting;
+
+/*
+ * Turn accounting on or off. Counts are reset when it is turned on. Reflow
+ * threads may allocate, so everything here is atomic.
+ */
+void
+xmalloc_set_accounting(int on)
+{
+	struct xmalloc_tag	*tag;
+
+	if (on && !__atomic_load_n(&xmalloc_accounting, __ATOMIC_RELAXED)) {
+		tag = __atomic_load_n(&xmalloc_tags, __ATOMIC_ACQUIRE);
+		for (; tag != NULL; tag = tag->next) {
+			__atomic_store_n(&tag->count, 0, __ATOMIC_RELAXED);
+			__atomic_store_n(&tag->bytes, 0, __ATOMIC_RELAXED);
+		}
+	}
+	__atomic_store_n(&xmalloc_accounting, on, __ATOMIC_RELAXED);
+}
+
+/* Count an allocation of size bytes against a file. */
+static void
+xmalloc_account(struct xmalloc_tag *tag, const char *file, size_t size)
+{
+	struct xmalloc_tag	*head;
+
+#ifdef NEED_BENCHMARKS
+	__atomic_fetch_add(&xmalloc_count, 1, __ATOMIC_RELAXED);
+#endif
+	if (!__atomic_load_n(&xmalloc_accounting, __ATOMIC_RELAXED))
+		return;
+
+	if (!__atomic_exchange_n(&tag->added, 1, __ATOMIC_ACQ_REL)) {
+		tag->file = file;
+		head = __atomic_load_n(&xmalloc_tags, __ATOMIC_RELAXED);
+		do
+			tag->next = head;
+		while (!__atomic_compare_exchange_n(&xmalloc_tags, &head, tag, 0,
+		    __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+	}
+	__atomic_fetch_add(&tag->count, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&tag->bytes, size, __ATOMIC_RELAXED);
+}
+
 void *
-xmalloc(size_t size)
+xmalloc_at(struct xmalloc_tag *tag, const char *file, size_t size)
 {
 	void *ptr;
 
 	if (size == 0)
 		fatalx("xmalloc: zero size");
+	xmalloc_account(tag, file, size);
 	ptr = malloc(size);
 	if (ptr == NULL)
 		fatalx("xmalloc: allocating %zu bytes: %s",
@@ -38,12 +91,14 @@ xmalloc(size_t size)
 }
 
 void *
-xcalloc(size_t nmemb, size_t size)
+xcalloc_at(struct xmalloc_tag *tag, const char *file, size_t nmemb,
+    size_t size)
 {
 	void *ptr;
 
 	if (size == 0 || nmemb == 0)
 		fatalx("xcalloc: zero size");
+	xmalloc_account(tag, file, nmemb * size);
 	ptr = calloc(nmemb, size);
 	if (ptr == NULL)
 		fatalx("xcalloc: allocating %zu * %zu bytes: %s",
@@ -52,18 +107,20 @@ xcalloc(size_t nmemb, size_t size)
 }
 
 void *
-xrealloc(void *ptr, size_t size)
+xrealloc_at(struct xmalloc_tag *tag, const char *file, void *ptr, size_t size)
 {
-	return xreallocarray(ptr, 1, size);
+	return xreallocarray_at(tag, file, ptr, 1, size);
 }
 
 void *
-xreallocarray(void *ptr, size_t nmemb, size_t size)
+xreallocarray_at(struct xmalloc_tag *tag, const char *file, void *ptr,
+    size_t nmemb, size_t size)
 {
 	void *new_ptr;
 
 	if (nmemb == 0 || size == 0)
 		fatalx("xreallocarray: zero size");
+	xmalloc_account(tag, file, nmemb * size);
 	new_ptr = reallocarray(ptr, nmemb, size);
 	if (new_ptr == NULL)
 		fatalx("xreallocarray: allocating %zu * %zu bytes: %s",
@@ -72,12 +129,14 @@ xreallocarray(void *ptr, size_t nmemb, size_t size)
 }
 
 void *
-xrecallocarray(void *ptr, size_t oldnmemb, size_t nmemb, size_t size)
+xrecallocarray_at(struct xmalloc_tag *tag, const char *file, void *ptr,
+    size_t oldnmemb, size_t nmemb, size_t size)
 {
 	void *new_ptr;
 
 	if (nmemb == 0 || size == 0)
 		fatalx("xrecallocarray: zero size");
+	xmalloc_account(tag, file, nmemb * size);
 	new_ptr = recallocarray(ptr, oldnmemb, nmemb, size);
 	if (new_ptr == NULL)
 		fatalx("xrecallocarray: allocating %zu * %zu bytes: %s",
@@ -86,31 +145,35 @@ xrecallocarray(void *ptr, size_t oldnmemb, size_t nmemb, size_t size)
 }
 
 char *
-xstrdup(const char *str)
+xstrdup_at(struct xmalloc_tag *tag, const char *file, const char *str)
 {
 	char *cp;
 
 	if ((cp = strdup(str)) == NULL)
 		fatalx("xstrdup: %s", strerror(errno));
+	xmalloc_account(tag, file, strlen(cp) + 1);
 	return cp;
 }
 
 char *
-xstrndup(const char *str, size_t maxlen)
+xstrndup_at(struct xmalloc_tag *tag, const char *file, const char *str,
+    size_t maxlen)
 {
 	char *cp;
 
 	if ((cp = strndup(str, maxlen)) == NULL)
 		fatalx("xstrndup: %s", strerror(errno));
+	xmalloc_account(tag, file, strlen(cp) + 1);
 	return cp;
 }
 
 char *
-xmemdup(const void *ptr, size_t len)
+xmemdup_at(struct xmalloc_tag *tag, const char *file, const void *ptr,
+    size_t len)
 {
 	char *cp;
 
-	cp = xmalloc(len + 1);
+	cp = xmalloc_at(tag, file, len + 1);
 	if (len != 0)
 		memcpy(cp, ptr, len);
 	cp[len] = '\0';
@@ -118,20 +181,22 @@ xmemdup(const void *ptr, size_t len)
 }
 
 int
-xasprintf(char **ret, const char *fmt, ...)
+xasprintf_at(struct xmalloc_tag *tag, const char *file, char **ret,
+    const char *fmt, ...)
 {
 	va_list ap;
 	int i;
 
 	va_start(ap, fmt);
-	i = xvasprintf(ret, fmt, ap);
+	i = xvasprintf_at(tag, file, ret, fmt, ap);
 	va_end(ap);
 
 	return i;
 }
 
 int
-xvasprintf(char **ret, const char *fmt, va_list ap)
+xvasprintf_at(struct xmalloc_tag *tag, const char *file, char **ret,
+    const char *fmt, va_list ap)
 {
 	int i;
 
@@ -139,6 +204,7 @@ xvasprintf(char **ret, const char *fmt, va_list ap)
 
 	if (i == -1)
 		fatalx("xasprintf: %s", strerror(errno));
+	xmalloc_account(tag, file, i + 1);
 
 	return i;
 }
@@ -23,20 +23,66 @@
 #define __bounded__(x, y, z)
 #endif
 
-void	*xmalloc(size_t);
-void	*xcalloc(size_t, size_t);
-void	*xrealloc(void *, size_t);
-void	*xreallocarray(void *, size_t, size_t);
-void	*xrecallocarray(void *, size_t, size_t, size_t);
-char	*xstrdup(const char *);
-char	*xstrndup(const char *, size_t);
-char	*xmemdup(const void *, size_t);
-int	 xasprintf(char **, const char *, ...)
-		__attribute__((__format__ (printf, 2, 3)))
-		__attribute__((__nonnull__ (2)));
-int	 xvasprintf(char **, const char *, va_list)
-		__attribute__((__format__ (printf, 2, 0)))
-		__attribute__((__nonnull__ (2)));
+/*
+ * When accounting is on, allocations are counted against the file which made
+ * them. Each file including this header has its own tag which is added to the
+ * list the first time it is used.
+ */
+struct xmalloc_tag {
+	const char		*file;
+	int			 added;
+	uint64_t		 count;
+	uint64_t		 bytes;
+	struct xmalloc_tag	*next;
+};
+static struct xmalloc_tag xmalloc_tag __attribute__((__unused__));
+
+#ifdef NEED_BENCHMARKS
+extern uint64_t		 xmalloc_count;
+#endif
+extern struct xmalloc_tag *xmalloc_tags;
+
+void	 xmalloc_set_accounting(int);
+
+#define xmalloc(size) \
+	xmalloc_at(&xmalloc_tag, __FILE__, size)
+#define xcalloc(nmemb, size) \
+	xcalloc_at(&xmalloc_tag, __FILE__, nmemb, size)
+#define xrealloc(ptr, size) \
+	xrealloc_at(&xmalloc_tag, __FILE__, ptr, size)
+#define xreallocarray(ptr, nmemb, size) \
+	xreallocarray_at(&xmalloc_tag, __FILE__, ptr, nmemb, size)
+#define xrecallocarray(ptr, oldnmemb, nmemb, size) \
+	xrecallocarray_at(&xmalloc_tag, __FILE__, ptr, oldnmemb, nmemb, size)
+#define xstrdup(str) \
+	xstrdup_at(&xmalloc_tag, __FILE__, str)
+#define xstrndup(str, maxlen) \
+	xstrndup_at(&xmalloc_tag, __FILE__, str, maxlen)
+#define xmemdup(ptr, len) \
+	xmemdup_at(&xmalloc_tag, __FILE__, ptr, len)
+#define xasprintf(ret, ...) \
+	xasprintf_at(&xmalloc_tag, __FILE__, ret, __VA_ARGS__)
+#define xvasprintf(ret, fmt, ap) \
+	xvasprintf_at(&xmalloc_tag, __FILE__, ret, fmt, ap)
+
+void	*xmalloc_at(struct xmalloc_tag *, const char *, size_t);
+void	*xcalloc_at(struct xmalloc_tag *, const char *, size_t, size_t);
+void	*xrealloc_at(struct xmalloc_tag *, const char *, void *, size_t);
+void	*xreallocarray_at(struct xmalloc_tag *, const char *, void *, size_t,
+	     size_t);
+void	*xrecallocarray_at(struct xmalloc_tag *, const char *, void *, size_t,
+	     size_t, size_t);
+char	*xstrdup_at(struct xmalloc_tag *, const char *, const char *);
+char	*xstrndup_at(struct xmalloc_tag *, const char *, const char *, size_t);
+char	*xmemdup_at(struct xmalloc_tag *, const char *, const void *, size_t);
+int	 xasprintf_at(struct xmalloc_tag *, const char *, char **,
+	     const char *, ...)
+		__attribute__((__format__ (printf, 4, 5)))
+		__attribute__((__nonnull__ (4)));
+int	 xvasprintf_at(struct xmalloc_tag *, const char *, char **,
+	     const char *, va_list)
+		__attribute__((__format__ (printf, 4, 0)))
+		__attribute__((__nonnull__ (4)));
 int	 xsnprintf(char *, size_t, const char *, ...)
 		__attribute__((__format__ (printf, 3, 4)))
 		__attribute__((__nonnull__ (3)))